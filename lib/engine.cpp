@@ -0,0 +1,477 @@
+#include "engine.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace json;
+using namespace json::detail;
+
+static bool is_digit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+void Input::reset(std::string_view view, std::size_t max_size) {
+    stream = nullptr;
+    truncated = view.size() > max_size;
+    cur = window = view.data();
+    passed = 0;
+    end = cur + std::min(view.size(), max_size);
+    view_end = cur + view.size();
+}
+
+void Input::reset(std::streambuf *buf, std::size_t max_size) {
+    if (buf == nullptr) {
+        throw std::runtime_error("JSON: Stream has no buffer.");
+    }
+    stream = buf;
+    remaining = max_size;
+    cur = end = window = block;
+    passed = 0;
+}
+
+bool Input::refill() {
+    if (stream == nullptr) {
+        if (truncated) {
+            throw std::runtime_error("JSON: Document is too large.");
+        }
+        return false;
+    }
+    if (remaining == 0) {
+        if (stream->sgetc() == std::streambuf::traits_type::eof()) {
+            return false;
+        }
+        throw std::runtime_error("JSON: Document is too large.");
+    }
+    // Only take what the stream already holds in memory, so every unread byte can be put back.
+    std::streamsize size = 0;
+    const std::streamsize available = stream->in_avail();
+    if (available > 0) {
+        const auto limit = static_cast<std::streamsize>(std::min(block_size, remaining));
+        size = stream->sgetn(block, std::min(available, limit));
+    } else if (available == 0) {
+        const auto ch = stream->sbumpc();
+        if (ch != std::streambuf::traits_type::eof()) {
+            block[0] = std::streambuf::traits_type::to_char_type(ch);
+            size = 1;
+        }
+    }
+    if (size <= 0) {
+        return false;
+    }
+    remaining -= static_cast<std::size_t>(size);
+    passed += static_cast<std::size_t>(end - window);
+    cur = block;
+    end = block + size;
+    return true;
+}
+
+void Input::remove_limit() {
+    if (stream == nullptr && truncated) {
+        end = view_end;
+        truncated = false;
+    }
+}
+
+void Input::finish() {
+    if (stream != nullptr) {
+        for (; cur != end; cur++) {
+            stream->sungetc();
+        }
+    }
+    cur = end;
+}
+
+void Tokenizer::reset(std::string_view view, const ParseLimits &new_limits, bool new_array_root) {
+    input.reset(view, new_limits.max_document_size);
+    start(new_limits, new_array_root);
+}
+
+void Tokenizer::reset(std::streambuf *buf, const ParseLimits &new_limits, bool new_array_root) {
+    input.reset(buf, new_limits.max_document_size);
+    start(new_limits, new_array_root);
+}
+
+void Tokenizer::start(const ParseLimits &new_limits, bool new_array_root) {
+    JSON_STATS(stats = {};
+               start_cycles = cycles();)
+    limits = new_limits;
+    array_root = new_array_root;
+    kernels = &detail::kernels();
+    containers.clear();
+    {
+        JSON_STATS(GrowthCounter growth(stats.estimated_allocations, containers);)
+        containers.reserve(std::min<std::size_t>(limits.max_depth, 1024));
+    }
+    elements = 0;
+    expect = Expect::Root;
+}
+
+void Tokenizer::expect_end() {
+    input.remove_limit();
+    char ch;
+    if (skip_whitespace(ch)) {
+        throw std::runtime_error("JSON: Unexpected data after the document.");
+    }
+}
+
+void Tokenizer::finish() {
+    input.finish();
+}
+
+Token Tokenizer::resume_object() {
+    if (expect != Expect::Root || array_root) {
+        throw std::runtime_error("JSON: excepted {");
+    }
+    return open('}');
+}
+
+bool Tokenizer::skip_whitespace(char &ch) {
+    while (input.cur != input.end || input.refill()) {
+        input.cur = kernels->skip_whitespace(input.cur, input.end);
+        if (input.cur != input.end) {
+            ch = *input.cur++;
+            return true;
+        }
+    }
+    return false;
+}
+
+Token Tokenizer::next() {
+    if (expect == Expect::Done) {
+        return Token::End;
+    }
+    char ch;
+    while (skip_whitespace(ch)) {
+        switch (expect) {
+            case Expect::Root:
+                if (array_root) {
+                    if (ch != '[') {
+                        throw std::runtime_error("JSON: excepted [");
+                    }
+                    return open(']');
+                }
+                if (ch != '{') {
+                    throw std::runtime_error("JSON: excepted {");
+                }
+                return open('}');
+            case Expect::KeyOrEnd:
+                if (ch == '}') {
+                    return close();
+                }
+                [[fallthrough]];
+            case Expect::Key:
+                if (ch != '\"') {
+                    throw std::runtime_error("JSON: Empty key");
+                }
+                read_string();
+                expect = Expect::Colon;
+                return Token::Key;
+            case Expect::Colon:
+                if (ch != ':') {
+                    throw std::runtime_error("JSON: excepted :");
+                }
+                expect = Expect::Value;
+                break;
+            case Expect::ValueOrEnd:
+                if (ch == ']') {
+                    return close();
+                }
+                [[fallthrough]];
+            case Expect::Value:
+                return read_value(ch);
+            case Expect::CommaOrEnd:
+                if (ch == containers.back()) {
+                    return close();
+                }
+                if (ch != ',') {
+                    throw std::runtime_error(containers.back() == '}' ? "JSON: excepted , or }" : "JSON: excepted , or ]");
+                }
+                expect = containers.back() == '}' ? Expect::Key : Expect::Value;
+                break;
+            case Expect::Done:
+                return Token::End;
+        }
+    }
+    throw std::runtime_error("JSON: Unexpected end of input.");
+}
+
+Token Tokenizer::read_value(char ch) {
+    if (ch == '{') {
+        return open('}');
+    }
+    if (ch == '[') {
+        return open(']');
+    }
+    count_element();
+    expect = Expect::CommaOrEnd;
+    if (ch == '\"') {
+        read_string();
+        return Token::String;
+    }
+    if (is_digit(ch)) {
+        read_number(ch);
+        return Token::Uint64;
+    }
+    if (ch == 't') {
+        read_literal("rue");
+        boolean_value = true;
+        return Token::Boolean;
+    }
+    if (ch == 'f') {
+        read_literal("alse");
+        boolean_value = false;
+        return Token::Boolean;
+    }
+    if (ch == 'n') {
+        read_literal("ull");
+        return Token::Null;
+    }
+    throw std::runtime_error("JSON: Excepted correct value type.");
+}
+
+Token Tokenizer::open(char closing) {
+    if (containers.size() >= limits.max_depth) {
+        throw std::runtime_error("JSON: Document is nested too deeply.");
+    }
+    count_element();
+    JSON_STATS(GrowthCounter growth(stats.estimated_allocations, containers);)
+    containers.push_back(closing);
+    if (closing == '}') {
+        expect = Expect::KeyOrEnd;
+        return Token::BeginObject;
+    }
+    expect = Expect::ValueOrEnd;
+    return Token::BeginArray;
+}
+
+Token Tokenizer::close() {
+    const char closing = containers.back();
+    containers.pop_back();
+    expect = containers.empty() ? Expect::Done : Expect::CommaOrEnd;
+    return closing == '}' ? Token::EndObject : Token::EndArray;
+}
+
+void Tokenizer::read_string() {
+    JSON_STATS(PhaseTimer timer(stats.string_cycles);)
+    scratch.clear();
+    while (true) {
+        const char *begin = input.cur;
+        const char *stop = kernels->find_quote(begin, input.end);
+        const char *quote = stop != input.end ? stop : nullptr;
+        const auto length = static_cast<std::size_t>(stop - begin);
+        if (scratch.size() + length > limits.max_string_length) {
+            throw std::runtime_error("JSON: String is too long.");
+        }
+        if (quote != nullptr && scratch.empty()) {
+            text_value = std::string_view(begin, length);
+            input.cur = quote + 1;
+            return;
+        }
+        {
+            JSON_STATS(GrowthCounter growth(stats.estimated_allocations, scratch);)
+            scratch.append(begin, length);
+        }
+        input.cur = stop;
+        if (quote != nullptr) {
+            input.cur++;
+            text_value = scratch;
+            return;
+        }
+        if (!input.refill()) {
+            throw std::runtime_error("JSON: Excepted \"");
+        }
+    }
+}
+
+void Tokenizer::read_number(char first) {
+    constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    // Any 19 digit number fits into uint64, so only longer ones need an overflow check.
+    constexpr std::size_t safe_digits = 19;
+    JSON_STATS(PhaseTimer timer(stats.number_cycles);)
+    std::uint64_t ans = first - '0';
+    std::size_t digits = 1;
+    while (input.cur != input.end || input.refill()) {
+        const char *stop = kernels->skip_digits(input.cur, input.end);
+        for (const char *p = input.cur; p != stop; p++) {
+            const auto digit = static_cast<std::uint64_t>(*p - '0');
+            if (++digits > safe_digits && ans > (max - digit) / 10) {
+                throw std::runtime_error("JSON: Number is too big.");
+            }
+            ans = ans * 10 + digit;
+        }
+        input.cur = stop;
+        if (stop != input.end) {
+            break;
+        }
+    }
+    number_value = ans;
+}
+
+void Tokenizer::read_literal(std::string_view rest) {
+    char ch;
+    for (const char expected: rest) {
+        if (!next_char(ch) || ch != expected) {
+            throw std::runtime_error("JSON: Incorrect value");
+        }
+    }
+}
+
+void Tokenizer::count_element() {
+    if (++elements > limits.max_elements) {
+        throw std::runtime_error("JSON: Too many elements.");
+    }
+}
+
+Value TreeBuilder::build(Tokenizer &tokenizer, Token token, SchemaValidator *validator) {
+    JSON_STATS(ParseStats &stats = tokenizer.stats;)
+    depth = 0;
+    for (;; token = tokenizer.next()) {
+        if (validator != nullptr) {
+            validator->accept(token, tokenizer);
+        }
+        Value value = Value::new_value(nullptr);
+        switch (token) {
+            case Token::BeginObject:
+            case Token::BeginArray:
+                JSON_STATS(token == Token::BeginObject ? stats.objects++ : stats.arrays++;)
+                if (depth == frames.size()) {
+                    JSON_STATS(GrowthCounter growth(stats.estimated_allocations, frames);)
+                    frames.emplace_back();
+                }
+                frames[depth].is_object = token == Token::BeginObject;
+                frames[depth].members.clear();
+                frames[depth].array.clear();
+                depth++;
+                continue;
+            case Token::Key: {
+                auto &members = frames[depth - 1].members;
+                JSON_STATS(stats.keys++;
+                           stats.estimated_allocations += allocates(tokenizer.text());
+                           GrowthCounter growth(stats.estimated_allocations, members);
+                           PhaseTimer timer(stats.insertion_cycles);)
+                members.emplace_back(tokenizer.text(), nullptr);
+                continue;
+            }
+            case Token::EndObject:
+            case Token::EndArray: {
+                JSON_STATS(PhaseTimer timer(stats.insertion_cycles);)
+                value = close_frame();
+                // One entry per distinct key, plus the bucket array unless the map still uses
+                // its inline single bucket.
+                JSON_STATS(if (value.is_object()) {
+                               const auto &object = value.to_object();
+                               stats.estimated_allocations += object.size() + (object.bucket_count() > 1);
+                           })
+                break;
+            }
+            case Token::String: {
+                JSON_STATS(stats.strings++;
+                           stats.estimated_allocations += allocates(tokenizer.text());
+                           PhaseTimer timer(stats.allocation_cycles);)
+                value = Value::new_value(std::string(tokenizer.text()));
+                break;
+            }
+            case Token::Uint64:
+                JSON_STATS(stats.numbers++;)
+                value = Value::new_value(tokenizer.number());
+                break;
+            case Token::Boolean:
+                JSON_STATS(stats.booleans++;)
+                value = Value::new_value(tokenizer.boolean());
+                break;
+            case Token::Null:
+                JSON_STATS(stats.nulls++;)
+                break;
+            case Token::End:
+                throw std::runtime_error("JSON: Unexpected end of input.");
+        }
+        if (depth == 0) {
+            return value;
+        }
+        value_ptr node;
+        {
+            JSON_STATS(stats.estimated_allocations++;
+                       PhaseTimer timer(stats.allocation_cycles);)
+            node = make_value(std::move(value));
+        }
+        JSON_STATS(PhaseTimer timer(stats.insertion_cycles);)
+        Frame &parent = frames[depth - 1];
+        if (parent.is_object) {
+            parent.members.back().second = std::move(node);
+        } else {
+            JSON_STATS(GrowthCounter growth(stats.estimated_allocations, parent.array);)
+            parent.array.push_back(std::move(node));
+        }
+    }
+}
+
+Value TreeBuilder::close_frame() {
+    Frame &frame = frames[--depth];
+    if (frame.is_object) {
+        Json::json_object object;
+        object.reserve(frame.members.size());
+        for (auto &[key, value]: frame.members) {
+            object.insert_or_assign(std::move(key), std::move(value));
+        }
+        frame.members.clear();
+        return Value::new_value(std::move(object));
+    }
+    return Value::new_value(std::move(frame.array));
+}
+
+Json json::detail::build_json(ParseState &state, Token first, const Schema *schema, bool whole_input) {
+    SchemaValidator *validator = nullptr;
+    if (schema != nullptr) {
+        state.validator.reset(*schema);
+        validator = &state.validator;
+    }
+    Value root = state.builder.build(state.tokenizer, first, validator);
+    JSON_STATS(ParseStats &stats = state.tokenizer.stats;
+               stats.bytes = state.tokenizer.consumed();)
+    if (whole_input) {
+        state.tokenizer.expect_end();
+    }
+    state.tokenizer.finish();
+    Json ans(std::move(root.to_object()));
+    JSON_STATS(stats.total_cycles = cycles() - state.tokenizer.start_cycles;
+               report_stats(stats);)
+    return ans;
+}
+
+#ifdef JSON_ENABLE_STATS
+namespace {
+    thread_local ParseStats last_stats;
+
+    std::function<void(const ParseStats &)> stats_callback;
+}
+
+void json::detail::report_stats(const ParseStats &stats) {
+    last_stats = stats;
+    if (stats_callback) {
+        stats_callback(stats);
+    }
+}
+#endif
+
+const ParseStats &json::last_parse_stats() {
+#ifdef JSON_ENABLE_STATS
+    return last_stats;
+#else
+    static const ParseStats empty;
+    return empty;
+#endif
+}
+
+void json::set_parse_stats_callback(std::function<void(const ParseStats &)> callback) {
+#ifdef JSON_ENABLE_STATS
+    stats_callback = std::move(callback);
+#else
+    static_cast<void>(callback);
+#endif
+}
+
+Json json::detail::parse_stream(std::istream &s, const ParseLimits &limits, bool resume_object, const Schema *schema) {
+    ParseState state;
+    state.tokenizer.reset(s.rdbuf(), limits);
+    return build_json(state, resume_object ? state.tokenizer.resume_object() : state.tokenizer.next(), schema);
+}
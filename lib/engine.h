@@ -0,0 +1,221 @@
+#pragma once
+
+#include "include/json.h"
+#include "include/json_schema.h"
+#include "kernels.h"
+#include "stats.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json::detail {
+
+    enum class Token : std::uint8_t {
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,
+        String,
+        Uint64,
+        Boolean,
+        Null,
+        End
+    };
+
+    // Contiguous window over the document. Views are scanned in place, streams are read in
+    // blocks and the bytes read past the end of the document are handed back by finish().
+    class Input {
+    public:
+        void reset(std::string_view view, std::size_t max_size);
+
+        void reset(std::streambuf *buf, std::size_t max_size);
+
+        // Called once cur == end. Returns false at the end of input.
+        bool refill();
+
+        void finish();
+
+        // Makes the rest of a view readable even past max_document_size, which only applies to
+        // the document itself and not to what follows it.
+        void remove_limit();
+
+        // Bytes taken from the input so far.
+        std::size_t consumed() const {
+            return passed + static_cast<std::size_t>(cur - window);
+        }
+
+        const char *cur = nullptr;
+        const char *end = nullptr;
+
+    private:
+        static constexpr std::size_t block_size = 4096;
+
+        std::streambuf *stream = nullptr;
+        const char *window = nullptr;
+        std::size_t passed = 0;
+        std::size_t remaining = 0;
+        const char *view_end = nullptr;
+        bool truncated = false;
+        char block[block_size];
+    };
+
+    // Pull tokenizer. Checks the grammar with an explicit container stack, so nesting depth
+    // costs no native stack, and enforces ParseLimits as it goes.
+    class Tokenizer {
+    public:
+        // The document must be an object, or an array when `array_root` is set.
+        void reset(std::string_view view, const ParseLimits &limits, bool array_root = false);
+
+        void reset(std::streambuf *buf, const ParseLimits &limits, bool array_root = false);
+
+        Token next();
+
+        // Acts as if the opening '{' of the document has already been consumed.
+        Token resume_object();
+
+        // Throws unless only whitespace is left in the input.
+        void expect_end();
+
+        void finish();
+
+        // Starts counting towards ParseLimits::max_elements from zero again.
+        void reset_element_count() {
+            elements = 0;
+        }
+
+        // Key or string contents, valid until the next call to next().
+        std::string_view text() const {
+            return text_value;
+        }
+
+        std::uint64_t number() const {
+            return number_value;
+        }
+
+        bool boolean() const {
+            return boolean_value;
+        }
+
+        std::size_t consumed() const {
+            return input.consumed();
+        }
+
+#ifdef JSON_ENABLE_STATS
+        // Counters of the current document, also updated by the TreeBuilder.
+        ParseStats stats;
+        std::uint64_t start_cycles = 0;
+#endif
+
+    private:
+        enum class Expect : std::uint8_t {
+            Root,
+            KeyOrEnd,
+            Key,
+            Colon,
+            ValueOrEnd,
+            Value,
+            CommaOrEnd,
+            Done
+        };
+
+        void start(const ParseLimits &new_limits, bool new_array_root);
+
+        bool next_char(char &ch) {
+            if (input.cur == input.end && !input.refill()) {
+                return false;
+            }
+            ch = *input.cur++;
+            return true;
+        }
+
+        bool skip_whitespace(char &ch);
+
+        Token read_value(char ch);
+
+        Token open(char closing);
+
+        Token close();
+
+        void read_string();
+
+        void read_number(char first);
+
+        void read_literal(std::string_view rest);
+
+        void count_element();
+
+        Input input;
+        const Kernels *kernels = nullptr;
+        ParseLimits limits;
+        std::vector<char> containers;
+        std::string scratch;
+        std::string_view text_value;
+        std::uint64_t number_value = 0;
+        bool boolean_value = false;
+        std::size_t elements = 0;
+        Expect expect = Expect::Root;
+        bool array_root = false;
+    };
+
+    // Checks the token stream against a compiled Schema while the tree is being built.
+    class SchemaValidator {
+    public:
+        void reset(const Schema &new_schema);
+
+        void accept(Token token, const Tokenizer &tokenizer);
+
+    private:
+        struct Frame {
+            std::size_t node;
+            bool is_object;
+            std::uint64_t seen;
+            std::size_t count;
+        };
+
+        void check_value(std::size_t node, Token token, const Tokenizer &tokenizer) const;
+
+        [[noreturn]] static void fail(const std::string &what);
+
+        const Schema *schema = nullptr;
+        std::vector<Frame> frames;
+        std::size_t pending = 0;
+    };
+
+    // Turns a token stream into a tree using an explicit stack of partially built containers.
+    class TreeBuilder {
+    public:
+        // Builds one complete value whose first token is `token`. Every token is shown to
+        // `validator` first when one is given.
+        Value build(Tokenizer &tokenizer, Token token, SchemaValidator *validator = nullptr);
+
+    private:
+        // Object members are collected in order and moved into a map sized for them when the
+        // object closes, so large objects are never rehashed while they grow.
+        struct Frame {
+            bool is_object = false;
+            std::vector<std::pair<std::string, value_ptr>> members;
+            std::vector<value_ptr> array;
+        };
+
+        Value close_frame();
+
+        std::vector<Frame> frames;
+        std::size_t depth = 0;
+    };
+
+    struct ParseState {
+        Tokenizer tokenizer;
+        TreeBuilder builder;
+        SchemaValidator validator;
+    };
+
+    // With `whole_input`, the document must take up the rest of the input apart from whitespace.
+    Json build_json(ParseState &state, Token first, const Schema *schema = nullptr, bool whole_input = false);
+
+    Json parse_stream(std::istream &s, const ParseLimits &limits, bool resume_object, const Schema *schema = nullptr);
+} // namespace json::detail
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -8,6 +9,11 @@
 #include <memory>
 #include <sstream>
 #include <algorithm>
+#include <istream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 
 namespace json {
 
@@ -20,11 +26,93 @@ namespace json {
         Null
     };
 
+    // Reference-counted pointer with a plain (non-atomic) counter stored next to the object.
+    // Only safe while every copy of the pointer stays on one thread.
+    template<typename T>
+    class local_ptr {
+    public:
+        local_ptr() = default;
+
+        local_ptr(std::nullptr_t) {}
+
+        local_ptr(const local_ptr &other) : node(other.node) {
+            if (node) {
+                node->count++;
+            }
+        }
+
+        local_ptr(local_ptr &&other) noexcept : node(std::exchange(other.node, nullptr)) {}
+
+        local_ptr &operator=(local_ptr other) noexcept {
+            std::swap(node, other.node);
+            return *this;
+        }
+
+        ~local_ptr() {
+            if (node && --node->count == 0) {
+                delete node;
+            }
+        }
+
+        T &operator*() const {
+            return node->value;
+        }
+
+        T *operator->() const {
+            return &node->value;
+        }
+
+        T *get() const {
+            return node ? &node->value : nullptr;
+        }
+
+        std::size_t use_count() const {
+            return node ? node->count : 0;
+        }
+
+        explicit operator bool() const {
+            return node != nullptr;
+        }
+
+        friend bool operator==(const local_ptr &lhs, const local_ptr &rhs) {
+            return lhs.node == rhs.node;
+        }
+
+        template<typename U, typename... Args>
+        friend local_ptr<U> make_local(Args &&...args);
+
+    private:
+        struct Node {
+            T value;
+            std::size_t count;
+        };
+
+        explicit local_ptr(Node *node) : node(node) {}
+
+        Node *node = nullptr;
+    };
+
+    template<typename T, typename... Args>
+    local_ptr<T> make_local(Args &&...args) {
+        return local_ptr<T>(new typename local_ptr<T>::Node{T(std::forward<Args>(args)...), 1});
+    }
+
     class Value;
 
+    // Node ownership policy, chosen with the JSON_NODE_OWNERSHIP CMake option.
+    // "shared" (default) uses std::shared_ptr; "local" drops atomic refcounting for
+    // documents that never leave their thread. A finished document may still be read
+    // from several threads in either mode as long as readers only take const references
+    // and never copy the pointers.
+#ifdef JSON_LOCAL_OWNERSHIP
+    using value_ptr = local_ptr<Value>;
+#else
+    using value_ptr = std::shared_ptr<Value>;
+#endif
+
     class Json {
     public:
-        using json_object = std::unordered_map<std::string, std::shared_ptr<Value>>;
+        using json_object = std::unordered_map<std::string, value_ptr>;
         using iterator = json_object::iterator;
         using const_iterator = json_object::const_iterator;
     public:
@@ -59,8 +147,12 @@ namespace json {
     public:
         Value(const Value &) = default;
 
+        Value(Value &&) noexcept = default;
+
         Value &operator=(const Value &v) = default;
 
+        Value &operator=(Value &&v) noexcept = default;
+
         static Value new_value(uint64_t value) {
             Value instance;
             instance.uint64_value = value;
@@ -68,9 +160,9 @@ namespace json {
             return instance;
         }
 
-        static Value new_value(const std::string &value) {
+        static Value new_value(std::string value) {
             Value instance;
-            instance.string_value = value;
+            instance.string_value = std::move(value);
             instance.value_type = ValueType::String;
             return instance;
         }
@@ -79,14 +171,18 @@ namespace json {
             return new_value(object.object);
         }
 
-        static Value new_value(const std::unordered_map<std::string, std::shared_ptr<Value>> &object) {
+        static Value new_value(Json &&object) {
+            return new_value(std::move(object.object));
+        }
+
+        static Value new_value(std::unordered_map<std::string, value_ptr> object) {
             Value instance;
-            instance.object_value = object;
+            instance.object_value = std::move(object);
             instance.value_type = ValueType::Object;
             return instance;
         }
 
-        static Value new_value(const std::vector<std::shared_ptr<Value>> &array) {
+        static Value new_value(std::vector<value_ptr> array) {
             if (!array.empty()) {
                 const ValueType type = array.front()->value_type;
                 if (!std::all_of(array.begin(), array.end(), [&type](const auto &item) {
@@ -96,7 +192,7 @@ namespace json {
                 }
             }
             Value instance;
-            instance.array_value = array;
+            instance.array_value = std::move(array);
             instance.value_type = ValueType::Array;
             return instance;
         }
@@ -131,9 +227,9 @@ namespace json {
 
         const std::string &to_string() const;
 
-        const std::unordered_map<std::string, std::shared_ptr<Value>> &to_object() const;
+        const std::unordered_map<std::string, value_ptr> &to_object() const;
 
-        const std::vector<std::shared_ptr<Value>> &to_array() const;
+        const std::vector<value_ptr> &to_array() const;
 
         bool to_boolean() const;
 
@@ -143,15 +239,15 @@ namespace json {
 
         std::string &to_string();
 
-        std::unordered_map<std::string, std::shared_ptr<Value>> &to_object();
+        std::unordered_map<std::string, value_ptr> &to_object();
 
-        std::vector<std::shared_ptr<Value>> &to_array();
+        std::vector<value_ptr> &to_array();
 
         bool &to_boolean();
 
-        const std::shared_ptr<Value> &at(const std::string &key) const;
+        const value_ptr &at(const std::string &key) const;
 
-        std::shared_ptr<Value> &at(const std::string &key);
+        value_ptr &at(const std::string &key);
 
         const Value &operator[](const std::string &key) const;
 
@@ -169,13 +265,122 @@ namespace json {
 
         std::uint64_t uint64_value{};
         std::string string_value;
-        std::unordered_map<std::string, std::shared_ptr<Value>> object_value;
-        std::vector<std::shared_ptr<Value>> array_value;
+        std::unordered_map<std::string, value_ptr> object_value;
+        std::vector<value_ptr> array_value;
         bool boolean_value{};
     };
 
 
+    inline value_ptr make_value(Value value) {
+#ifdef JSON_LOCAL_OWNERSHIP
+        return make_local<Value>(std::move(value));
+#else
+        return std::make_shared<Value>(std::move(value));
+#endif
+    }
+
+    struct ParseLimits {
+        std::size_t max_depth = 1024;
+        std::size_t max_document_size = std::numeric_limits<std::size_t>::max();
+        std::size_t max_string_length = std::numeric_limits<std::size_t>::max();
+        std::size_t max_elements = std::numeric_limits<std::size_t>::max();
+    };
+
+    // Instruction set used by the scanning kernels of the tokenizer, ordered from least to most capable.
+    enum class Isa : std::uint8_t {
+        Scalar,
+        Sse2,
+        Avx2,
+        Avx512
+    };
+
+    // Best instruction set supported by this CPU, detected once at startup.
+    Isa detected_isa();
+
+    Isa active_isa();
+
+    // Overrides the detected instruction set, e.g. to test a fallback path. Affects parses started
+    // afterwards. Throws if the CPU doesn't support `isa`.
+    void set_isa(Isa isa);
+
+    // Counters for one document parsed by parse_json() or Parser. They are only collected when the
+    // library is built with JSON_ENABLE_STATS, see parse_stats_enabled. Cycles are time stamp counter
+    // ticks on x86 and nanoseconds elsewhere.
+    struct ParseStats {
+        std::uint64_t total_cycles = 0;
+        // Scanning key and string contents.
+        std::uint64_t string_cycles = 0;
+        // Converting digits to numbers.
+        std::uint64_t number_cycles = 0;
+        // Creating values and tree nodes.
+        std::uint64_t allocation_cycles = 0;
+        // Adding nodes to their arrays and objects.
+        std::uint64_t insertion_cycles = 0;
+        std::uint64_t objects = 0;
+        std::uint64_t arrays = 0;
+        std::uint64_t keys = 0;
+        std::uint64_t strings = 0;
+        std::uint64_t numbers = 0;
+        std::uint64_t booleans = 0;
+        std::uint64_t nulls = 0;
+        std::uint64_t bytes = 0;
+        // Estimate of the heap allocations made by the tokenizer and tree builder. Buffer growth
+        // and nodes are counted as they happen; strings past the small string buffer, object
+        // entries and bucket arrays are inferred, which matches libstdc++ and may differ with
+        // other standard libraries. Schema validation is not included.
+        std::uint64_t estimated_allocations = 0;
+    };
+
+#ifdef JSON_ENABLE_STATS
+    inline constexpr bool parse_stats_enabled = true;
+#else
+    inline constexpr bool parse_stats_enabled = false;
+#endif
+
+    // Stats of the last document parsed on this thread.
+    const ParseStats &last_parse_stats();
+
+    // Called on the parsing thread after each document. Not synchronized with running parses, so
+    // set it before they start. An empty function removes the callback.
+    void set_parse_stats_callback(std::function<void(const ParseStats &)> callback);
+
+    namespace detail {
+        struct ParseState;
+    }
+
+    class Schema;
+
     Json parse_json(std::istream &s, char last_char = ' ');
 
+    Json parse_json(std::istream &s, const ParseLimits &limits);
+
     void dump_json(std::ostream &out, const Json &object);
+
+    // Reusable parser for many small documents. Reads the input in place instead of copying
+    // it into a std::istringstream and keeps its scratch buffers and stacks between calls. Each
+    // input must hold exactly one document; anything but whitespace after it is an error.
+    class Parser {
+    public:
+        explicit Parser(ParseLimits limits = {});
+
+        ~Parser();
+
+        Parser(const Parser &) = delete;
+
+        Parser &operator=(const Parser &) = delete;
+
+        Json parse(std::string_view input);
+
+        // Validates against `schema` while parsing and throws at the first violation.
+        Json parse(std::string_view input, const Schema &schema);
+
+        std::vector<Json> parse_many(std::span<const std::string_view> inputs);
+
+        // Forgets the last input and clears any error state left by a failed parse.
+        void reset();
+
+    private:
+        ParseLimits limits;
+        std::unique_ptr<detail::ParseState> state;
+    };
 } // namespace json
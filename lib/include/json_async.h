@@ -0,0 +1,226 @@
+#pragma once
+
+#include "json.h"
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace json {
+
+    // Byte producer for async_parse. Implementations hand out chunks without blocking and
+    // resume the waiting coroutine once more data (or the end of input) is available.
+    //
+    // One coroutine reads from a source at a time, but producers may push from other threads,
+    // so every method must be safe to call concurrently with them. on_readable() must check for
+    // data and register the handle atomically with respect to producers; otherwise a chunk pushed
+    // in between is never noticed. The handle may be resumed on the producer's thread.
+    class AsyncByteSource {
+    public:
+        virtual ~AsyncByteSource() = default;
+
+        // Moves the next buffered chunk into `chunk`. Returns false if nothing is buffered right now.
+        virtual bool try_read(std::string &chunk) = 0;
+
+        // True once the producer has closed the source and every chunk has been read.
+        virtual bool exhausted() const = 0;
+
+        // Registers `handle` to be resumed when a chunk arrives or the source is closed. Returns
+        // false without registering if either has already happened, so the caller doesn't suspend.
+        virtual bool on_readable(std::coroutine_handle<> handle) = 0;
+
+        // Forgets `handle` registered by on_readable(). Called when the waiting coroutine is
+        // destroyed before it was resumed, e.g. because its Task was dropped.
+        virtual void cancel(std::coroutine_handle<> handle) = 0;
+    };
+
+    // In-memory source: the producer pushes chunks, the consumer coroutine is resumed inline on
+    // the pushing thread. Thread-safe.
+    class ChunkQueueSource : public AsyncByteSource {
+    public:
+        void push(std::string chunk);
+
+        void close();
+
+        bool try_read(std::string &chunk) override;
+
+        bool exhausted() const override;
+
+        bool on_readable(std::coroutine_handle<> handle) override;
+
+        void cancel(std::coroutine_handle<> handle) override;
+
+    private:
+        void wake(std::unique_lock<std::mutex> &lock);
+
+        mutable std::mutex mutex;
+        std::deque<std::string> chunks;
+        std::coroutine_handle<> waiter;
+        bool closed = false;
+    };
+
+    // Awaitable yielding the next chunk of a source, or std::nullopt once it is exhausted.
+    class ReadChunk {
+    public:
+        explicit ReadChunk(AsyncByteSource &source) : source(source) {}
+
+        ReadChunk(const ReadChunk &) = delete;
+
+        ReadChunk &operator=(const ReadChunk &) = delete;
+
+        ~ReadChunk() {
+            if (waiting) {
+                source.cancel(waiting);
+            }
+        }
+
+        bool await_ready() {
+            has_chunk = source.try_read(chunk);
+            return has_chunk || source.exhausted();
+        }
+
+        // Once the handle is registered another thread may resume it and destroy this awaiter,
+        // so nothing is touched after a successful registration.
+        bool await_suspend(std::coroutine_handle<> handle) {
+            waiting = handle;
+            if (!source.on_readable(handle)) {
+                waiting = {};
+                return false;
+            }
+            return true;
+        }
+
+        std::optional<std::string> await_resume() {
+            waiting = {};
+            if (!has_chunk && !source.try_read(chunk)) {
+                return std::nullopt;
+            }
+            return std::move(chunk);
+        }
+
+    private:
+        AsyncByteSource &source;
+        std::string chunk;
+        std::coroutine_handle<> waiting;
+        bool has_chunk = false;
+    };
+
+    // Eagerly started coroutine result. Either co_await it from another coroutine or poll
+    // done() and call get() once the producer has fed enough input.
+    template<typename T>
+    class Task {
+    public:
+        struct promise_type {
+            std::optional<T> value;
+            std::exception_ptr error;
+            std::coroutine_handle<> continuation;
+            // Set by whichever comes second of the coroutine finishing and an awaiter storing its
+            // continuation; that side is the one that resumes the awaiter.
+            std::atomic<bool> handoff{false};
+            std::atomic<bool> finished{false};
+
+            Task get_return_object() {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            auto final_suspend() noexcept {
+                struct FinalAwaiter {
+                    bool await_ready() noexcept {
+                        return false;
+                    }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                        handle.promise().finished.store(true, std::memory_order_release);
+                        if (handle.promise().handoff.exchange(true, std::memory_order_acq_rel)) {
+                            return handle.promise().continuation;
+                        }
+                        return std::noop_coroutine();
+                    }
+
+                    void await_resume() noexcept {}
+                };
+                return FinalAwaiter{};
+            }
+
+            void return_value(T result) {
+                value = std::move(result);
+            }
+
+            void unhandled_exception() {
+                error = std::current_exception();
+            }
+        };
+
+        Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+        Task &operator=(Task &&other) noexcept {
+            if (this != &other) {
+                if (handle) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+
+        Task &operator=(const Task &) = delete;
+
+        ~Task() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        // Safe to poll from another thread than the one running the coroutine.
+        bool done() const {
+            return handle && handle.promise().finished.load(std::memory_order_acquire);
+        }
+
+        T get() {
+            if (!done()) {
+                throw std::runtime_error("JSON: Task is not finished yet.");
+            }
+            if (handle.promise().error) {
+                std::rethrow_exception(handle.promise().error);
+            }
+            return std::move(*handle.promise().value);
+        }
+
+        // The task may finish on another thread at any moment, so readiness is only decided by
+        // the handoff in await_suspend.
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> continuation) {
+            handle.promise().continuation = continuation;
+            return !handle.promise().handoff.exchange(true, std::memory_order_acq_rel);
+        }
+
+        T await_resume() {
+            return get();
+        }
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    // Parses one top-level object, suspending whenever the source runs dry.
+    // Bytes following the closing '}' in the last chunk are ignored.
+    // ParseLimits::max_document_size and max_depth are already enforced while the document is
+    // being buffered, so a client that never finishes its object can't grow memory without bound.
+    Task<Json> async_parse(AsyncByteSource &source, ParseLimits limits = {});
+} // namespace json
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "json.h"
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace json {
+
+    // Canonical form: no whitespace, object keys sorted bytewise, numbers in plain decimal.
+    // Equal documents always serialize to the same bytes, the same ones transcode produces
+    // with Style::Canonical.
+    void dump_canonical(std::ostream &out, const Json &object);
+
+    void dump_canonical(std::ostream &out, const Value &value);
+
+    // XXH64 (seed 0) of the canonical form, computed while walking the tree without
+    // materializing the serialized string. Stable across runs, processes and platforms.
+    std::uint64_t fingerprint(const Json &object);
+
+    std::uint64_t fingerprint(const Value &value);
+
+    // XXH64 (seed 0) of raw bytes, e.g. of an already canonical document.
+    std::uint64_t fingerprint(std::string_view bytes);
+} // namespace json
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "json.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+    // Read-only index over a large object. Keys are packed into one buffer and looked up by
+    // a binary search over sorted 64-bit key hashes, which takes far less memory than the
+    // per-member nodes of an unordered_map. Values are shared with the source object.
+    // Safe to read from several threads at once.
+    class FrozenObject {
+    public:
+        explicit FrozenObject(const Value &object);
+
+        explicit FrozenObject(const Json &object);
+
+        std::size_t size() const;
+
+        bool contains_key(std::string_view key) const;
+
+        // Returns nullptr if the key doesn't exist.
+        const Value *find(std::string_view key) const;
+
+        const Value &operator[](std::string_view key) const;
+
+        // Members in index order, which is neither insertion nor key order.
+        std::string_view key(std::size_t index) const;
+
+        const Value &value(std::size_t index) const;
+
+    private:
+        template<typename Object>
+        void build(const Object &object);
+
+        std::size_t lower_bound(std::uint64_t hash) const;
+
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::uint32_t> key_offsets;
+        std::string keys;
+        std::vector<value_ptr> values;
+    };
+} // namespace json
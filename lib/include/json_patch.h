@@ -0,0 +1,27 @@
+#pragma once
+
+#include "json.h"
+#include <string>
+
+namespace json {
+
+    struct DiffOptions {
+        // Array elements that are objects carrying this key are matched by the key's value,
+        // so reordered records become move operations and inserted ones a single add, rather
+        // than a cascade of field changes. An empty key matches elements by content only.
+        std::string array_key = "id";
+    };
+
+    // Returns an RFC 6902 JSON Patch (an array of operation objects) that turns `from` into `to`.
+    // Identical subtrees are skipped by comparing subtree hashes before descending into them.
+    Value diff(const Value &from, const Value &to, const DiffOptions &options = {});
+
+    Value diff(const Json &from, const Json &to, const DiffOptions &options = {});
+
+    // Applies an RFC 6902 patch in place. Supports add, remove, replace, move, copy and test.
+    // Throws std::runtime_error on the first operation that cannot be applied, including one that
+    // would mix value types in an array; operations before it stay applied.
+    void apply_patch(Value &document, const Value &patch);
+
+    void apply_patch(Json &document, const Value &patch);
+} // namespace json
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "json.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace json {
+
+    namespace detail {
+        class SchemaValidator;
+    }
+
+    // JSON Schema subset compiled into a flat table of nodes. The parser feeds it every token
+    // and stops at the first violation, before the rest of the document is read or built.
+    //
+    // Supported keywords: type (a name or an array of names; "number" and "integer" both mean
+    // an unsigned integer), properties, required, items, enum (scalar values only), minimum,
+    // maximum and maxItems. Other keywords are rejected by compile().
+    class Schema {
+    public:
+        static Schema compile(const Value &schema);
+
+        static Schema compile(const Json &schema);
+
+    private:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        struct Property {
+            std::string name;
+            std::size_t node;
+            std::uint64_t required_bit;
+        };
+
+        struct Node {
+            std::uint8_t types = 0xff;
+            std::vector<Property> properties;
+            std::uint64_t required_mask = 0;
+            std::size_t items = npos;
+            // Kept apart from the values, since an empty enum matches nothing.
+            bool has_enum = false;
+            std::vector<Value> enum_values;
+            std::uint64_t minimum = 0;
+            std::uint64_t maximum = std::numeric_limits<std::uint64_t>::max();
+            std::size_t max_items = std::numeric_limits<std::size_t>::max();
+        };
+
+        Schema() = default;
+
+        std::size_t compile_node(const Value &schema);
+
+        static const Property *find_property(const Node &node, std::string_view name);
+
+        std::vector<Node> nodes;
+
+        friend class detail::SchemaValidator;
+    };
+
+    Json parse_json(std::istream &s, const Schema &schema, const ParseLimits &limits = {});
+} // namespace json
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "json.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace json {
+
+    // Reads a document whose top level is an array one element at a time. Only the current
+    // element is kept in memory: it is released before the next one is parsed, and the parse
+    // stacks and buffers are reused between elements.
+    //
+    // ParseLimits::max_elements applies to each element separately; the other limits apply to
+    // the whole input. A string_view input can be a memory-mapped file.
+    class ArrayStream {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value *;
+            using reference = Value &;
+
+            iterator() = default;
+
+            Value &operator*() const;
+
+            Value *operator->() const;
+
+            iterator &operator++();
+
+            void operator++(int);
+
+            friend bool operator==(const iterator &it, std::default_sentinel_t) {
+                return it.at_end();
+            }
+
+        private:
+            bool at_end() const;
+
+            explicit iterator(ArrayStream *stream) : stream(stream) {}
+
+            ArrayStream *stream = nullptr;
+
+            friend class ArrayStream;
+        };
+
+        explicit ArrayStream(std::istream &input, const ParseLimits &limits = {});
+
+        explicit ArrayStream(std::string_view input, const ParseLimits &limits = {});
+
+        ArrayStream(const ArrayStream &) = delete;
+
+        ArrayStream &operator=(const ArrayStream &) = delete;
+
+        ~ArrayStream();
+
+        // Elements can only be walked once; begin() continues from the current element.
+        iterator begin();
+
+        std::default_sentinel_t end() const {
+            return {};
+        }
+
+    private:
+        void advance();
+
+        std::unique_ptr<detail::ParseState> state;
+        std::optional<Value> current;
+        bool started = false;
+    };
+} // namespace json
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "json.h"
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace json {
+
+    enum class Style : std::uint8_t {
+        // No whitespace at all.
+        Compact,
+        // One member or element per line, indented by Format::indent spaces.
+        Pretty,
+        // Compact with object keys sorted bytewise; the last of duplicate keys wins.
+        Canonical
+    };
+
+    struct Format {
+        Style style = Style::Compact;
+        std::size_t indent = 4;
+    };
+
+    // Reformats a document token by token without building a tree, validating it on the way by the
+    // same rules as parse_json, including that array elements share one type.
+    // Compact and pretty output use constant memory; canonical output has to hold the members
+    // of each open object until it is closed so they can be sorted.
+    void transcode(std::istream &input, std::ostream &output, const Format &format = {},
+                   const ParseLimits &limits = {});
+
+    // Like Parser, anything but whitespace after the document is an error.
+    void transcode(std::string_view input, std::ostream &output, const Format &format = {},
+                   const ParseLimits &limits = {});
+} // namespace json
@@ -1,4 +1,5 @@
 #include "include/json.h"
+#include "engine.h"
 #include <stdexcept>
 #include <memory>
 #include <iostream>
@@ -43,12 +44,12 @@ const std::string &Value::to_string() const {
     return string_value;
 }
 
-const std::unordered_map<std::string, std::shared_ptr<Value>> &Value::to_object() const {
+const std::unordered_map<std::string, value_ptr> &Value::to_object() const {
     CHECK_TYPE(is_object)
     return object_value;
 }
 
-const std::vector<std::shared_ptr<Value>> &Value::to_array() const {
+const std::vector<value_ptr> &Value::to_array() const {
     CHECK_TYPE(is_array)
     return array_value;
 }
@@ -73,12 +74,12 @@ std::string &Value::to_string() {
     return string_value;
 }
 
-std::unordered_map<std::string, std::shared_ptr<Value>> &Value::to_object() {
+std::unordered_map<std::string, value_ptr> &Value::to_object() {
     CHECK_TYPE(is_object)
     return object_value;
 }
 
-std::vector<std::shared_ptr<Value>> &Value::to_array() {
+std::vector<value_ptr> &Value::to_array() {
     CHECK_TYPE(is_array)
     return array_value;
 }
@@ -88,14 +89,14 @@ bool &Value::to_boolean() {
     return boolean_value;
 }
 
-const std::shared_ptr<Value> &Value::at(const std::string &key) const {
+const value_ptr &Value::at(const std::string &key) const {
     if (!is_object()) {
         throw std::runtime_error("JSON: This is not an object!");
     }
     return to_object().at(key);
 }
 
-std::shared_ptr<Value> &Value::at(const std::string &key) {
+value_ptr &Value::at(const std::string &key) {
     if (!is_object()) {
         throw std::runtime_error("JSON: This is not an object!");
     }
@@ -133,7 +134,10 @@ bool json::operator==(const Value &lhs, const Value &rhs) {
         if (lhs.to_array().size() != rhs.to_array().size()) {
             return false;
         }
-        return std::equal(lhs.to_array().begin(), lhs.to_array().end(), rhs.to_array().begin());
+        return std::equal(lhs.to_array().begin(), lhs.to_array().end(), rhs.to_array().begin(),
+                          [](const auto &lhs_item, const auto &rhs_item) {
+                              return *lhs_item == *rhs_item;
+                          });
     }
     if (lhs.is_uint64()) {
         return lhs.to_uint64() == rhs.to_uint64();
@@ -164,7 +168,7 @@ const Value &Json::operator[](const std::string &key) const {
 
 Value &Json::operator[](const std::string &key) {
     if (!contains_key(key)) {
-        object[key] = std::make_shared<Value>(Value::new_value(nullptr));
+        object[key] = make_value(Value::new_value(nullptr));
     }
     return *object[key];
 }
@@ -189,159 +193,12 @@ Json::const_iterator Json::end() const {
     return object.end();
 }
 
-static std::string parse_string(std::istream &s, char &ch) {
-    std::string key;
-    while (s >> ch && ch != '\"') {
-        key += std::string(1, ch);
-    }
-    if (ch != '\"') {
-        throw std::runtime_error("JSON: Excepted \"");
-    }
-    return key;
-}
-
-static std::uint64_t parse_uint64(std::istream &s, char &ch) {
-    uint64_t ans = ch - '0';
-    while (s >> ch && isdigit(ch)) {
-        ans = ans * 10 + (ch - '0');
-    }
-    if (ch != ' ' && ch != ',' && ch != '}' && ch != ']') {
-        throw std::runtime_error("JSON: excepted ,");
-    }
-    return ans;
-}
-
-static bool parse_boolean(std::istream &s, char &ch) {
-    s >> ch;
-    if (ch == 'r' && s >> ch && ch == 'u' && s >> ch && ch == 'e') {
-        s >> ch;
-        while (ch == ' ') {
-            s >> ch;
-        }
-        if (ch != ',' && ch != '}') {
-            throw std::runtime_error("JSON: excepted , or }");
-        }
-        return true;
-    } else if (ch == 'a' && s >> ch && ch == 'l' && s >> ch && ch == 's' && s >> ch && ch == 'e') {
-        s >> ch;
-        while (ch == ' ') {
-            s >> ch;
-        }
-        if (ch != ',' && ch != '}' && ch != ']') {
-            throw std::runtime_error("JSON: excepted , or }");
-        }
-        return false;
-    }
-    throw std::runtime_error("JSON: Incorrect value");
-}
-
-static std::nullptr_t parse_null(std::istream &s, char &ch) {
-    s >> ch;
-    if (ch == 'u' && s >> ch && ch == 'l' && s >> ch && ch == 'l') {
-        s >> ch;
-        while (ch == ' ') {
-            s >> ch;
-        }
-        if (ch != ',' && ch != '}' && ch != ']') {
-            throw std::runtime_error("JSON: excepted , or }");
-        }
-        return nullptr;
-    }
-    throw std::runtime_error("JSON: Incorrect value");
-}
-
-
-static std::vector<std::shared_ptr<Value>> parse_array(std::istream &s, char &ch) {
-    std::vector<std::shared_ptr<Value>> ans;
-    while (s >> ch && ch != ']') {
-        if (ch == '\"') {
-            ans.push_back(std::make_shared<Value>(Value::new_value(parse_string(s, ch))));
-        } else if (isdigit(ch)) {
-            ans.push_back(std::make_shared<Value>(Value::new_value(parse_uint64(s, ch))));
-        } else if (ch == 't' || ch == 'f') {
-            ans.push_back(std::make_shared<Value>(Value::new_value(parse_boolean(s, ch))));
-        } else if (ch == 'n') {
-            ans.push_back(std::make_shared<Value>(Value::new_value(parse_null(s, ch))));
-        } else if (ch == '[') {
-            ans.push_back(std::make_shared<Value>(Value::new_value(parse_array(s, ch))));
-        } else if (ch == '{') {
-            ans.push_back(std::make_shared<Value>(Value::new_value(parse_json(s, ch))));
-        } else if (ch != ' ' && ch != ',') {
-            throw std::runtime_error("JSON: Incorrect array");
-        }
-        if (ch == ']') {
-            break;
-        }
-    }
-    if (ch != ']') {
-        throw std::runtime_error("JSON: excepted ]");
-    }
-    s >> ch;
-    while (ch == ' ') {
-        s >> ch;
-    }
-    if (ch != ',' && ch != '}' && ch != ']') {
-        throw std::runtime_error("JSON: excepted , or }");
-    }
-    return ans;
+Json json::parse_json(std::istream &s, char last_char) {
+    return detail::parse_stream(s, {}, last_char == '{');
 }
 
-Json json::parse_json(std::istream &s, char last_char) {
-    Json ans;
-    std::string key;
-    char ch;
-    if (last_char != '{') {
-        s >> ch;
-        if (ch != '{') {
-            throw std::runtime_error("JSON: excepted {");
-        }
-    }
-    while (s >> ch) {
-        if (ch == ' ' || ch == '\n' || ch == ',') continue;
-        if (ch == '\"' && key.empty()) {
-            key = parse_string(s, ch);
-        } else if (ch == ':') {
-
-        } else if (ch == '}') {
-            break;
-        } else {
-            if (key.empty()) {
-                throw std::runtime_error("JSON: Empty key");
-            }
-            if (ch == '\"') {
-                ans[key] = Value::new_value(parse_string(s, ch));
-                key.clear();
-            } else if (isdigit(ch)) {
-                ans[key] = Value::new_value(parse_uint64(s, ch));
-                key.clear();
-            } else if (ch == '{') {
-                ans[key] = Value::new_value(parse_json(s, ch));
-                key.clear();
-            } else if (ch == '[') {
-                ans[key] = Value::new_value(parse_array(s, ch));
-                key.clear();
-            } else if (ch == 't' || ch == 'f') {
-                ans[key] = Value::new_value(parse_boolean(s, ch));
-                key.clear();
-            } else if (ch == 'n') {
-                ans[key] = Value::new_value(parse_null(s, ch));
-                key.clear();
-            } else {
-                throw std::runtime_error("JSON: Excepted correct value type.");
-            }
-            if (ch == '}') {
-                if (!key.empty()) {
-                    throw std::runtime_error("JSON: Excepted correct value type.");
-                }
-                key.clear();
-                break;
-            }
-        }
-    }
-    if (!key.empty()) {
-        throw std::runtime_error("JSON: Excepted correct value type.");
-    }
-    return ans;
+Json json::parse_json(std::istream &s, const ParseLimits &limits) {
+    return detail::parse_stream(s, limits, false);
 }
 
 static void dump_string(std::ostream &out, const std::string &str) {
@@ -366,7 +223,7 @@ static void dump_null(std::ostream &out) {
     out << "null";
 }
 
-static void dump_array(std::ostream &out, const std::vector<std::shared_ptr<Value>> &array) {
+static void dump_array(std::ostream &out, const std::vector<value_ptr> &array) {
     out << '[';
     for (std::size_t i = 0; i < array.size(); i++) {
         if (i != 0) {
@@ -415,4 +272,31 @@ void json::dump_json(std::ostream &out, const json::Json &object) {
         out << "\n";
     }
     out << "}\n";
-}
\ No newline at end of file
+}
+
+Parser::Parser(ParseLimits limits) : limits(limits), state(std::make_unique<detail::ParseState>()) {}
+
+Parser::~Parser() = default;
+
+Json Parser::parse(std::string_view input) {
+    state->tokenizer.reset(input, limits);
+    return detail::build_json(*state, state->tokenizer.next(), nullptr, true);
+}
+
+Json Parser::parse(std::string_view input, const Schema &schema) {
+    state->tokenizer.reset(input, limits);
+    return detail::build_json(*state, state->tokenizer.next(), &schema, true);
+}
+
+std::vector<Json> Parser::parse_many(std::span<const std::string_view> inputs) {
+    std::vector<Json> ans;
+    ans.reserve(inputs.size());
+    for (const auto &input: inputs) {
+        ans.push_back(parse(input));
+    }
+    return ans;
+}
+
+void Parser::reset() {
+    state->tokenizer.reset(std::string_view(), limits);
+}
@@ -0,0 +1,123 @@
+#include "include/json_async.h"
+#include <cctype>
+
+using namespace json;
+
+void ChunkQueueSource::push(std::string chunk) {
+    std::unique_lock lock(mutex);
+    if (closed) {
+        throw std::runtime_error("JSON: Source is already closed.");
+    }
+    chunks.push_back(std::move(chunk));
+    wake(lock);
+}
+
+void ChunkQueueSource::close() {
+    std::unique_lock lock(mutex);
+    closed = true;
+    wake(lock);
+}
+
+bool ChunkQueueSource::try_read(std::string &chunk) {
+    std::lock_guard lock(mutex);
+    if (chunks.empty()) {
+        return false;
+    }
+    chunk = std::move(chunks.front());
+    chunks.pop_front();
+    return true;
+}
+
+bool ChunkQueueSource::exhausted() const {
+    std::lock_guard lock(mutex);
+    return closed && chunks.empty();
+}
+
+bool ChunkQueueSource::on_readable(std::coroutine_handle<> handle) {
+    std::lock_guard lock(mutex);
+    if (!chunks.empty() || closed) {
+        return false;
+    }
+    waiter = handle;
+    return true;
+}
+
+void ChunkQueueSource::cancel(std::coroutine_handle<> handle) {
+    std::lock_guard lock(mutex);
+    if (waiter == handle) {
+        waiter = {};
+    }
+}
+
+// The waiter is resumed without the lock held, since it will call back into the source.
+void ChunkQueueSource::wake(std::unique_lock<std::mutex> &lock) {
+    const std::coroutine_handle<> handle = std::exchange(waiter, {});
+    lock.unlock();
+    if (handle) {
+        handle.resume();
+    }
+}
+
+namespace {
+    // Finds where the top-level object ends without building anything, so the DOM is
+    // only constructed once the whole document has arrived.
+    class DocumentScanner {
+    public:
+        explicit DocumentScanner(std::size_t max_depth) : max_depth(max_depth) {}
+
+        // Returns the number of bytes of `chunk` that belong to the document.
+        std::size_t feed(const std::string &chunk) {
+            for (std::size_t i = 0; i < chunk.size(); i++) {
+                const char ch = chunk[i];
+                if (in_string) {
+                    in_string = ch != '\"';
+                } else if (ch == '\"') {
+                    in_string = true;
+                } else if (ch == '{' || (ch == '[' && depth != 0)) {
+                    if (++depth > max_depth) {
+                        throw std::runtime_error("JSON: Document is nested too deeply.");
+                    }
+                } else if (ch == '}' || ch == ']') {
+                    if (depth == 0) {
+                        throw std::runtime_error("JSON: excepted {");
+                    }
+                    if (--depth == 0) {
+                        finished = true;
+                        return i + 1;
+                    }
+                } else if (depth == 0 && !std::isspace(static_cast<unsigned char>(ch))) {
+                    throw std::runtime_error("JSON: excepted {");
+                }
+            }
+            return chunk.size();
+        }
+
+        bool complete() const {
+            return finished;
+        }
+
+    private:
+        std::size_t max_depth;
+        std::size_t depth = 0;
+        bool in_string = false;
+        bool finished = false;
+    };
+}
+
+// Limits are taken by value: a reference could dangle once the coroutine suspends.
+Task<Json> json::async_parse(AsyncByteSource &source, ParseLimits limits) {
+    DocumentScanner scanner(limits.max_depth);
+    std::string document;
+    while (!scanner.complete()) {
+        std::optional<std::string> chunk = co_await ReadChunk(source);
+        if (!chunk) {
+            throw std::runtime_error("JSON: Unexpected end of input.");
+        }
+        const std::size_t size = scanner.feed(*chunk);
+        if (size > limits.max_document_size - document.size()) {
+            throw std::runtime_error("JSON: Document is too large.");
+        }
+        document.append(*chunk, 0, size);
+    }
+    co_return Parser(limits).parse(document);
+}
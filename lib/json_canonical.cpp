@@ -0,0 +1,243 @@
+#include "include/json_canonical.h"
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <vector>
+
+using namespace json;
+
+namespace {
+    constexpr std::uint64_t prime1 = 11400714785074694791ULL;
+    constexpr std::uint64_t prime2 = 14029467366897019727ULL;
+    constexpr std::uint64_t prime3 = 1609587929392839161ULL;
+    constexpr std::uint64_t prime4 = 9650029242287828579ULL;
+    constexpr std::uint64_t prime5 = 2870177450012600261ULL;
+
+    std::uint64_t read64(const unsigned char *p) {
+        std::uint64_t ans = 0;
+        for (int i = 7; i >= 0; i--) {
+            ans = (ans << 8) | p[i];
+        }
+        return ans;
+    }
+
+    std::uint32_t read32(const unsigned char *p) {
+        return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+               static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+    std::uint64_t mix_round(std::uint64_t acc, std::uint64_t input) {
+        acc += input * prime2;
+        acc = std::rotl(acc, 31);
+        return acc * prime1;
+    }
+
+    std::uint64_t merge_round(std::uint64_t acc, std::uint64_t value) {
+        acc ^= mix_round(0, value);
+        return acc * prime1 + prime4;
+    }
+
+    // Streaming XXH64 with seed 0.
+    class Hasher {
+    public:
+        void update(const char *data, std::size_t size) {
+            const auto *p = reinterpret_cast<const unsigned char *>(data);
+            total += size;
+            if (buffered + size < stripe) {
+                std::copy(p, p + size, buffer + buffered);
+                buffered += size;
+                return;
+            }
+            if (buffered != 0) {
+                const std::size_t fill = stripe - buffered;
+                std::copy(p, p + fill, buffer + buffered);
+                consume(buffer);
+                p += fill;
+                size -= fill;
+                buffered = 0;
+            }
+            for (; size >= stripe; p += stripe, size -= stripe) {
+                consume(p);
+            }
+            std::copy(p, p + size, buffer);
+            buffered = size;
+        }
+
+        void update(std::string_view text) {
+            update(text.data(), text.size());
+        }
+
+        void update(char ch) {
+            update(&ch, 1);
+        }
+
+        std::uint64_t digest() const {
+            std::uint64_t h;
+            if (total >= stripe) {
+                h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) + std::rotl(acc[2], 12) + std::rotl(acc[3], 18);
+                for (const std::uint64_t lane: acc) {
+                    h = merge_round(h, lane);
+                }
+            } else {
+                h = prime5;
+            }
+            h += total;
+            const unsigned char *p = buffer;
+            const unsigned char *end = buffer + buffered;
+            for (; end - p >= 8; p += 8) {
+                h ^= mix_round(0, read64(p));
+                h = std::rotl(h, 27) * prime1 + prime4;
+            }
+            if (end - p >= 4) {
+                h ^= read32(p) * prime1;
+                h = std::rotl(h, 23) * prime2 + prime3;
+                p += 4;
+            }
+            for (; p != end; p++) {
+                h ^= *p * prime5;
+                h = std::rotl(h, 11) * prime1;
+            }
+            h ^= h >> 33;
+            h *= prime2;
+            h ^= h >> 29;
+            h *= prime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+    private:
+        static constexpr std::size_t stripe = 32;
+
+        void consume(const unsigned char *p) {
+            for (std::size_t i = 0; i < 4; i++) {
+                acc[i] = mix_round(acc[i], read64(p + 8 * i));
+            }
+        }
+
+        std::uint64_t acc[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+        unsigned char buffer[stripe]{};
+        std::size_t buffered = 0;
+        std::uint64_t total = 0;
+    };
+
+    class StreamSink {
+    public:
+        explicit StreamSink(std::ostream &out) : out(out) {}
+
+        ~StreamSink() {
+            flush();
+        }
+
+        void update(std::string_view text) {
+            buffer += text;
+            if (buffer.size() >= 1 << 16) {
+                flush();
+            }
+        }
+
+        void update(char ch) {
+            buffer += ch;
+        }
+
+    private:
+        void flush() {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+
+        std::ostream &out;
+        std::string buffer;
+    };
+
+    template<typename Sink, typename Object>
+    void write_object(Sink &sink, const Object &object);
+
+    template<typename Sink>
+    void write_value(Sink &sink, const Value &value) {
+        if (value.is_object()) {
+            write_object(sink, value.to_object());
+        } else if (value.is_array()) {
+            sink.update('[');
+            bool first = true;
+            for (const auto &item: value.to_array()) {
+                if (!first) {
+                    sink.update(',');
+                }
+                first = false;
+                write_value(sink, *item);
+            }
+            sink.update(']');
+        } else if (value.is_string()) {
+            sink.update('\"');
+            sink.update(value.to_string());
+            sink.update('\"');
+        } else if (value.is_uint64()) {
+            char digits[20];
+            std::size_t size = 0;
+            std::uint64_t number = value.to_uint64();
+            do {
+                digits[sizeof(digits) - ++size] = static_cast<char>('0' + number % 10);
+                number /= 10;
+            } while (number != 0);
+            sink.update(std::string_view(digits + sizeof(digits) - size, size));
+        } else if (value.is_boolean()) {
+            sink.update(value.to_boolean() ? "true" : "false");
+        } else {
+            sink.update("null");
+        }
+    }
+
+    // Works on both Json and Json::json_object.
+    template<typename Sink, typename Object>
+    void write_object(Sink &sink, const Object &object) {
+        std::vector<const Json::json_object::value_type *> members;
+        members.reserve(object.size());
+        for (const auto &item: object) {
+            members.push_back(&item);
+        }
+        std::sort(members.begin(), members.end(), [](const auto *lhs, const auto *rhs) {
+            return lhs->first < rhs->first;
+        });
+        sink.update('{');
+        bool first = true;
+        for (const auto *member: members) {
+            if (!first) {
+                sink.update(',');
+            }
+            first = false;
+            sink.update('\"');
+            sink.update(member->first);
+            sink.update("\":");
+            write_value(sink, *member->second);
+        }
+        sink.update('}');
+    }
+}
+
+void json::dump_canonical(std::ostream &out, const Json &object) {
+    StreamSink sink(out);
+    write_object(sink, object);
+}
+
+void json::dump_canonical(std::ostream &out, const Value &value) {
+    StreamSink sink(out);
+    write_value(sink, value);
+}
+
+std::uint64_t json::fingerprint(const Json &object) {
+    Hasher hasher;
+    write_object(hasher, object);
+    return hasher.digest();
+}
+
+std::uint64_t json::fingerprint(const Value &value) {
+    Hasher hasher;
+    write_value(hasher, value);
+    return hasher.digest();
+}
+
+std::uint64_t json::fingerprint(std::string_view bytes) {
+    Hasher hasher;
+    hasher.update(bytes);
+    return hasher.digest();
+}
@@ -0,0 +1,98 @@
+#include "include/json_frozen.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using namespace json;
+
+static std::uint64_t hash_key(std::string_view key) {
+    return std::hash<std::string_view>()(key);
+}
+
+FrozenObject::FrozenObject(const Value &object) {
+    build(object.to_object());
+}
+
+FrozenObject::FrozenObject(const Json &object) {
+    build(object);
+}
+
+template<typename Object>
+void FrozenObject::build(const Object &object) {
+    std::vector<std::pair<std::uint64_t, const Json::json_object::value_type *>> members;
+    members.reserve(object.size());
+    std::size_t key_bytes = 0;
+    for (const auto &item: object) {
+        members.emplace_back(hash_key(item.first), &item);
+        key_bytes += item.first.size();
+    }
+    if (key_bytes > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("JSON: Object keys are too large to freeze.");
+    }
+    std::sort(members.begin(), members.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first < rhs.first;
+    });
+    hashes.reserve(members.size());
+    key_offsets.reserve(members.size() + 1);
+    keys.reserve(key_bytes);
+    values.reserve(members.size());
+    for (const auto &[hash, member]: members) {
+        hashes.push_back(hash);
+        key_offsets.push_back(static_cast<std::uint32_t>(keys.size()));
+        keys += member->first;
+        values.push_back(member->second);
+    }
+    key_offsets.push_back(static_cast<std::uint32_t>(keys.size()));
+}
+
+std::size_t FrozenObject::size() const {
+    return hashes.size();
+}
+
+// Branchless binary search: the loop has a fixed trip count and compiles to conditional moves,
+// so it doesn't suffer from mispredicted branches on random keys.
+std::size_t FrozenObject::lower_bound(std::uint64_t hash) const {
+    const std::uint64_t *base = hashes.data();
+    std::size_t length = hashes.size();
+    if (length == 0) {
+        return 0;
+    }
+    while (length > 1) {
+        const std::size_t half = length / 2;
+        base = base[half - 1] < hash ? base + half : base;
+        length -= half;
+    }
+    return static_cast<std::size_t>(base - hashes.data()) + (*base < hash);
+}
+
+const Value *FrozenObject::find(std::string_view key) const {
+    const std::uint64_t hash = hash_key(key);
+    for (std::size_t i = lower_bound(hash); i < hashes.size() && hashes[i] == hash; i++) {
+        if (this->key(i) == key) {
+            return values[i].get();
+        }
+    }
+    return nullptr;
+}
+
+bool FrozenObject::contains_key(std::string_view key) const {
+    return find(key) != nullptr;
+}
+
+const Value &FrozenObject::operator[](std::string_view key) const {
+    const Value *value = find(key);
+    if (value == nullptr) {
+        throw std::runtime_error("This key doesn't exist");
+    }
+    return *value;
+}
+
+std::string_view FrozenObject::key(std::size_t index) const {
+    return std::string_view(keys).substr(key_offsets[index], key_offsets[index + 1] - key_offsets[index]);
+}
+
+const Value &FrozenObject::value(std::size_t index) const {
+    return *values[index];
+}
@@ -0,0 +1,602 @@
+#include "include/json_patch.h"
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace json;
+
+namespace {
+    std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    std::string escape_token(const std::string &token) {
+        std::string ans;
+        ans.reserve(token.size());
+        for (const char ch: token) {
+            if (ch == '~') {
+                ans += "~0";
+            } else if (ch == '/') {
+                ans += "~1";
+            } else {
+                ans += ch;
+            }
+        }
+        return ans;
+    }
+
+    ValueType type_of(const Value &value) {
+        if (value.is_uint64()) {
+            return ValueType::Uint64;
+        }
+        if (value.is_string()) {
+            return ValueType::String;
+        }
+        if (value.is_object()) {
+            return ValueType::Object;
+        }
+        if (value.is_array()) {
+            return ValueType::Array;
+        }
+        return value.is_boolean() ? ValueType::Boolean : ValueType::Null;
+    }
+
+    value_ptr string_value(std::string value) {
+        return make_value(Value::new_value(std::move(value)));
+    }
+
+    // Largest middle section (product of both lengths) for which arrays are aligned with an
+    // LCS table; bigger arrays fall back to positional comparison.
+    constexpr std::size_t max_alignment_cells = 1 << 20;
+
+    class Differ {
+    public:
+        explicit Differ(const DiffOptions &options) : options(options) {}
+
+        void compare(const Value &from, const Value &to, std::string &path) {
+            if (&from == &to || same(from, to)) {
+                return;
+            }
+            if (from.is_object() && to.is_object()) {
+                compare_objects(from, to, path);
+            } else if (from.is_array() && to.is_array()) {
+                compare_arrays(from, to, path);
+            } else {
+                emit("replace", path, &to);
+            }
+        }
+
+        std::vector<value_ptr> operations;
+
+    private:
+        std::uint64_t hash(const Value &value) {
+            const auto it = hashes.find(&value);
+            if (it != hashes.end()) {
+                return it->second;
+            }
+            std::uint64_t ans;
+            if (value.is_object()) {
+                // Members are combined with a commutative sum so iteration order does not matter.
+                ans = 1;
+                for (const auto &item: value.to_object()) {
+                    ans += mix(std::hash<std::string>()(item.first) ^ hash(*item.second));
+                }
+            } else if (value.is_array()) {
+                ans = 2;
+                for (const auto &item: value.to_array()) {
+                    ans = mix(ans ^ hash(*item));
+                }
+            } else if (value.is_string()) {
+                ans = std::hash<std::string>()(value.to_string()) ^ 3;
+            } else if (value.is_uint64()) {
+                ans = value.to_uint64() * 8 + 4;
+            } else if (value.is_boolean()) {
+                ans = value.to_boolean() ? 5 : 6;
+            } else {
+                ans = 7;
+            }
+            ans = mix(ans);
+            hashes.emplace(&value, ans);
+            return ans;
+        }
+
+        bool same(const Value &lhs, const Value &rhs) {
+            return hash(lhs) == hash(rhs) && lhs == rhs;
+        }
+
+        const Value *identity_key(const Value &value) const {
+            if (options.array_key.empty() || !value.is_object()) {
+                return nullptr;
+            }
+            const auto it = value.to_object().find(options.array_key);
+            return it == value.to_object().end() ? nullptr : it->second.get();
+        }
+
+        bool matches(const Value &lhs, const Value &rhs) {
+            const Value *lhs_key = identity_key(lhs);
+            const Value *rhs_key = identity_key(rhs);
+            if (lhs_key != nullptr && rhs_key != nullptr) {
+                return same(*lhs_key, *rhs_key);
+            }
+            return lhs_key == nullptr && rhs_key == nullptr && same(lhs, rhs);
+        }
+
+        void compare_objects(const Value &from, const Value &to, std::string &path) {
+            const auto &lhs = from.to_object();
+            const auto &rhs = to.to_object();
+            const std::size_t length = path.size();
+            for (const auto &item: lhs) {
+                if (!rhs.count(item.first)) {
+                    path += '/' + escape_token(item.first);
+                    emit("remove", path, nullptr);
+                    path.resize(length);
+                }
+            }
+            for (const auto &item: rhs) {
+                path += '/' + escape_token(item.first);
+                const auto it = lhs.find(item.first);
+                if (it == lhs.end()) {
+                    emit("add", path, item.second.get());
+                } else {
+                    compare(*it->second, *item.second, path);
+                }
+                path.resize(length);
+            }
+        }
+
+        void compare_arrays(const Value &from, const Value &to, std::string &path) {
+            const auto &lhs = from.to_array();
+            const auto &rhs = to.to_array();
+            // Every intermediate array must stay homogeneous, so a change of element type
+            // replaces the whole array.
+            if (!lhs.empty() && !rhs.empty() && type_of(*lhs.front()) != type_of(*rhs.front())) {
+                emit("replace", path, &to);
+                return;
+            }
+            std::size_t begin = 0;
+            while (begin < lhs.size() && begin < rhs.size() && same(*lhs[begin], *rhs[begin])) {
+                begin++;
+            }
+            std::size_t lhs_end = lhs.size();
+            std::size_t rhs_end = rhs.size();
+            while (lhs_end > begin && rhs_end > begin && same(*lhs[lhs_end - 1], *rhs[rhs_end - 1])) {
+                lhs_end--;
+                rhs_end--;
+            }
+            const std::size_t lhs_size = lhs_end - begin;
+            const std::size_t rhs_size = rhs_end - begin;
+            const auto left = [&](std::size_t i) -> const Value & {
+                return *lhs[begin + i];
+            };
+            const auto right = [&](std::size_t j) -> const Value & {
+                return *rhs[begin + j];
+            };
+
+            std::vector<std::pair<std::size_t, std::size_t>> pairs;
+            if (lhs_size * rhs_size <= max_alignment_cells) {
+                // Longest common subsequence of matching elements.
+                const std::size_t width = rhs_size + 1;
+                std::vector<std::uint32_t> table((lhs_size + 1) * width);
+                for (std::size_t i = lhs_size; i-- > 0;) {
+                    for (std::size_t j = rhs_size; j-- > 0;) {
+                        table[i * width + j] = matches(left(i), right(j))
+                                               ? table[(i + 1) * width + j + 1] + 1
+                                               : std::max(table[(i + 1) * width + j], table[i * width + j + 1]);
+                    }
+                }
+                std::size_t i = 0;
+                std::size_t j = 0;
+                while (i < lhs_size && j < rhs_size) {
+                    if (matches(left(i), right(j))) {
+                        pairs.emplace_back(i++, j++);
+                    } else if (table[(i + 1) * width + j] >= table[i * width + j + 1]) {
+                        i++;
+                    } else {
+                        j++;
+                    }
+                }
+            }
+
+            // Where each target element comes from: an element of `from`, or `added` when it is new.
+            // Aligned elements keep their place, keyed records found elsewhere are moved, and the
+            // rest of each unaligned run is paired up by position.
+            constexpr std::size_t added = std::numeric_limits<std::size_t>::max();
+            std::vector<std::size_t> source(rhs_size, added);
+            std::vector<bool> used(lhs_size);
+            std::vector<bool> moved(rhs_size);
+            for (const auto &[i, j]: pairs) {
+                source[j] = i;
+                used[i] = true;
+            }
+            std::unordered_map<std::uint64_t, std::vector<std::size_t>> keyed;
+            for (std::size_t i = lhs_size; i-- > 0;) {
+                if (!used[i] && identity_key(left(i)) != nullptr) {
+                    keyed[hash(*identity_key(left(i)))].push_back(i);
+                }
+            }
+            for (std::size_t j = 0; j < rhs_size && !keyed.empty(); j++) {
+                const Value *key = source[j] == added ? identity_key(right(j)) : nullptr;
+                const auto it = key == nullptr ? keyed.end() : keyed.find(hash(*key));
+                if (it == keyed.end()) {
+                    continue;
+                }
+                for (std::size_t k = it->second.size(); k-- > 0;) {
+                    const std::size_t i = it->second[k];
+                    if (same(*identity_key(left(i)), *key)) {
+                        source[j] = i;
+                        used[i] = true;
+                        moved[j] = true;
+                        it->second.erase(it->second.begin() + static_cast<std::ptrdiff_t>(k));
+                        break;
+                    }
+                }
+            }
+            pairs.emplace_back(lhs_size, rhs_size);
+            std::size_t i = 0;
+            std::size_t j = 0;
+            for (const auto &[next_i, next_j]: pairs) {
+                while (true) {
+                    while (i < next_i && used[i]) {
+                        i++;
+                    }
+                    while (j < next_j && source[j] != added) {
+                        j++;
+                    }
+                    if (i == next_i || j == next_j) {
+                        break;
+                    }
+                    source[j] = i;
+                    used[i] = true;
+                }
+                i = next_i + 1;
+                j = next_j + 1;
+            }
+
+            // Removals go first, from the back so that earlier indices stay valid. Then the target
+            // is built front to back; `work` mirrors the array as the operations change it.
+            const std::size_t length = path.size();
+            std::vector<std::size_t> work;
+            work.reserve(std::max(lhs_size, rhs_size));
+            for (std::size_t k = lhs_size; k-- > 0;) {
+                if (!used[k]) {
+                    emit("remove", path + '/' + std::to_string(begin + k), nullptr);
+                }
+            }
+            for (std::size_t k = 0; k < lhs_size; k++) {
+                if (used[k]) {
+                    work.push_back(k);
+                }
+            }
+            std::vector<std::size_t> target(lhs_size, added);
+            for (std::size_t k = 0; k < rhs_size; k++) {
+                if (moved[k]) {
+                    target[source[k]] = k;
+                }
+            }
+            std::vector<bool> deferred(lhs_size);
+            for (j = 0; j < rhs_size; j++) {
+                // A record waiting in front of an element that stays is sent ahead to its target
+                // once, so a single reordered record costs one move rather than one per element it passed.
+                while (j < work.size() && work[j] != source[j] && target[work[j]] != added && !deferred[work[j]]) {
+                    const std::size_t record = work[j];
+                    deferred[record] = true;
+                    const std::size_t to_index = std::min(target[record], work.size() - 1);
+                    if (to_index == j) {
+                        break;
+                    }
+                    work.erase(work.begin() + static_cast<std::ptrdiff_t>(j));
+                    work.insert(work.begin() + static_cast<std::ptrdiff_t>(to_index), record);
+                    emit_move(path, begin + j, begin + to_index);
+                }
+                if (source[j] == added) {
+                    emit("add", path + '/' + std::to_string(begin + j), &right(j));
+                    work.insert(work.begin() + static_cast<std::ptrdiff_t>(j), added);
+                    continue;
+                }
+                if (work[j] != source[j]) {
+                    const auto it = std::find(work.begin() + static_cast<std::ptrdiff_t>(j), work.end(), source[j]);
+                    const auto from_index = static_cast<std::size_t>(it - work.begin());
+                    work.erase(it);
+                    work.insert(work.begin() + static_cast<std::ptrdiff_t>(j), source[j]);
+                    emit_move(path, begin + from_index, begin + j);
+                }
+                path += '/' + std::to_string(begin + j);
+                if (!moved[j] && (identity_key(left(source[j])) != nullptr || identity_key(right(j)) != nullptr) &&
+                    !matches(left(source[j]), right(j))) {
+                    // Different records that only share a position.
+                    emit("replace", path, &right(j));
+                } else {
+                    compare(left(source[j]), right(j), path);
+                }
+                path.resize(length);
+            }
+        }
+
+        void emit(const char *op, const std::string &path, const Value *value) {
+            Json::json_object operation;
+            operation["op"] = string_value(op);
+            operation["path"] = string_value(path);
+            if (value != nullptr) {
+                operation["value"] = make_value(*value);
+            }
+            operations.push_back(make_value(Value::new_value(std::move(operation))));
+        }
+
+        void emit_move(const std::string &path, std::size_t from_index, std::size_t to_index) {
+            Json::json_object operation;
+            operation["op"] = string_value("move");
+            operation["from"] = string_value(path + '/' + std::to_string(from_index));
+            operation["path"] = string_value(path + '/' + std::to_string(to_index));
+            operations.push_back(make_value(Value::new_value(std::move(operation))));
+        }
+
+        const DiffOptions &options;
+        std::unordered_map<const Value *, std::uint64_t> hashes;
+    };
+
+    value_ptr clone(const Value &value) {
+        if (value.is_object()) {
+            Json::json_object object;
+            object.reserve(value.to_object().size());
+            for (const auto &item: value.to_object()) {
+                object.emplace(item.first, clone(*item.second));
+            }
+            return make_value(Value::new_value(std::move(object)));
+        }
+        if (value.is_array()) {
+            std::vector<value_ptr> array;
+            array.reserve(value.to_array().size());
+            for (const auto &item: value.to_array()) {
+                array.push_back(clone(*item));
+            }
+            return make_value(Value::new_value(std::move(array)));
+        }
+        return make_value(value);
+    }
+
+    std::vector<std::string> split_pointer(const std::string &pointer) {
+        std::vector<std::string> tokens;
+        if (pointer.empty()) {
+            return tokens;
+        }
+        if (pointer.front() != '/') {
+            throw std::runtime_error("JSON: Pointer must start with /");
+        }
+        for (std::size_t i = 0; i < pointer.size(); i++) {
+            const char ch = pointer[i];
+            if (ch == '/') {
+                tokens.emplace_back();
+            } else if (ch == '~') {
+                if (i + 1 == pointer.size() || (pointer[i + 1] != '0' && pointer[i + 1] != '1')) {
+                    throw std::runtime_error("JSON: Incorrect pointer escape.");
+                }
+                tokens.back() += pointer[++i] == '0' ? '~' : '/';
+            } else {
+                tokens.back() += ch;
+            }
+        }
+        return tokens;
+    }
+
+    std::size_t parse_index(const std::string &token, std::size_t size) {
+        if (token.empty() || token.size() > 19 || (token.size() > 1 && token.front() == '0') ||
+            !std::all_of(token.begin(), token.end(), [](char ch) { return ch >= '0' && ch <= '9'; })) {
+            throw std::runtime_error("JSON: Incorrect array index.");
+        }
+        const std::size_t index = std::stoull(token);
+        if (index >= size) {
+            throw std::runtime_error("JSON: Array index is out of range.");
+        }
+        return index;
+    }
+
+    // Location inside a document: a parent container and the last pointer token.
+    struct Location {
+        Value *parent = nullptr;
+        std::string token;
+    };
+
+    class Patcher {
+    public:
+        // With `object_root`, operations that would put anything but an object at the root fail.
+        Patcher(Value &document, bool object_root) : document(document), object_root(object_root) {}
+
+        void apply(const Value &operation) {
+            const std::string &op = field(operation, "op").to_string();
+            const std::string &path = field(operation, "path").to_string();
+            if (op == "add") {
+                add(path, clone(field(operation, "value")));
+            } else if (op == "remove") {
+                take(path);
+            } else if (op == "replace") {
+                replace(path, clone(field(operation, "value")));
+            } else if (op == "move") {
+                const std::string &from = field(operation, "from").to_string();
+                if (path.compare(0, from.size(), from) == 0 && (path.size() == from.size() || path[from.size()] == '/')) {
+                    if (path.size() == from.size()) {
+                        return;
+                    }
+                    throw std::runtime_error("JSON: Can't move a value into itself.");
+                }
+                // Put the value back if it can't be added, so a failed operation changes nothing.
+                value_ptr value = take(from);
+                try {
+                    add(path, value);
+                } catch (const std::runtime_error &) {
+                    add(from, std::move(value));
+                    throw;
+                }
+            } else if (op == "copy") {
+                add(path, clone(get(field(operation, "from").to_string())));
+            } else if (op == "test") {
+                if (get(path) != field(operation, "value")) {
+                    throw std::runtime_error("JSON: Patch test failed.");
+                }
+            } else {
+                throw std::runtime_error("JSON: Unknown patch operation " + op);
+            }
+        }
+
+    private:
+        static const Value &field(const Value &operation, const std::string &name) {
+            if (!operation.is_object() || !operation.to_object().count(name)) {
+                throw std::runtime_error("JSON: Patch operation has no " + name);
+            }
+            return operation[name];
+        }
+
+        // Arrays hold values of a single type (see Value::new_value), so a new element must match
+        // the ones that stay, i.e. all but the one at `skip`.
+        static void check_element(const std::vector<value_ptr> &array, std::size_t skip, const Value &value) {
+            for (std::size_t i = 0; i < array.size(); i++) {
+                if (i != skip) {
+                    if (type_of(*array[i]) != type_of(value)) {
+                        throw std::runtime_error("JSON: Array can contains only values with similar types.");
+                    }
+                    return;
+                }
+            }
+        }
+
+        Value &resolve(Value &root, const std::vector<std::string> &tokens, std::size_t count) {
+            Value *current = &root;
+            for (std::size_t i = 0; i < count; i++) {
+                if (current->is_object()) {
+                    const auto it = current->to_object().find(tokens[i]);
+                    if (it == current->to_object().end()) {
+                        throw std::runtime_error("JSON: Path doesn't exist.");
+                    }
+                    current = it->second.get();
+                } else if (current->is_array()) {
+                    current = current->to_array()[parse_index(tokens[i], current->to_array().size())].get();
+                } else {
+                    throw std::runtime_error("JSON: Path doesn't exist.");
+                }
+            }
+            return *current;
+        }
+
+        Location locate(const std::string &path) {
+            std::vector<std::string> tokens = split_pointer(path);
+            if (tokens.empty()) {
+                return {};
+            }
+            Value &parent = resolve(document, tokens, tokens.size() - 1);
+            if (!parent.is_object() && !parent.is_array()) {
+                throw std::runtime_error("JSON: Path doesn't exist.");
+            }
+            return {&parent, std::move(tokens.back())};
+        }
+
+        const Value &get(const std::string &path) {
+            const std::vector<std::string> tokens = split_pointer(path);
+            return resolve(document, tokens, tokens.size());
+        }
+
+        void add(const std::string &path, value_ptr value) {
+            Location location = locate(path);
+            if (location.parent == nullptr) {
+                set_root(std::move(value));
+            } else if (location.parent->is_object()) {
+                location.parent->to_object().insert_or_assign(std::move(location.token), std::move(value));
+            } else {
+                auto &array = location.parent->to_array();
+                const std::size_t index = location.token == "-" ? array.size()
+                                                                : parse_index(location.token, array.size() + 1);
+                check_element(array, array.size(), *value);
+                array.insert(array.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+            }
+        }
+
+        value_ptr take(const std::string &path) {
+            Location location = locate(path);
+            if (location.parent == nullptr) {
+                throw std::runtime_error("JSON: Can't remove the root.");
+            }
+            value_ptr ans;
+            if (location.parent->is_object()) {
+                auto &object = location.parent->to_object();
+                const auto it = object.find(location.token);
+                if (it == object.end()) {
+                    throw std::runtime_error("JSON: Path doesn't exist.");
+                }
+                ans = std::move(it->second);
+                object.erase(it);
+            } else {
+                auto &array = location.parent->to_array();
+                const auto it = array.begin() + static_cast<std::ptrdiff_t>(parse_index(location.token, array.size()));
+                ans = std::move(*it);
+                array.erase(it);
+            }
+            return ans;
+        }
+
+        void replace(const std::string &path, value_ptr value) {
+            Location location = locate(path);
+            if (location.parent == nullptr) {
+                set_root(std::move(value));
+            } else if (location.parent->is_object()) {
+                const auto it = location.parent->to_object().find(location.token);
+                if (it == location.parent->to_object().end()) {
+                    throw std::runtime_error("JSON: Path doesn't exist.");
+                }
+                it->second = std::move(value);
+            } else {
+                auto &array = location.parent->to_array();
+                const std::size_t index = parse_index(location.token, array.size());
+                check_element(array, index, *value);
+                array[index] = std::move(value);
+            }
+        }
+
+        void set_root(value_ptr value) {
+            if (object_root && !value->is_object()) {
+                throw std::runtime_error("JSON: Patch must leave an object at the root.");
+            }
+            document = std::move(*value);
+        }
+
+        Value &document;
+        bool object_root;
+    };
+}
+
+Value json::diff(const Value &from, const Value &to, const DiffOptions &options) {
+    Differ differ(options);
+    std::string path;
+    differ.compare(from, to, path);
+    return Value::new_value(std::move(differ.operations));
+}
+
+Value json::diff(const Json &from, const Json &to, const DiffOptions &options) {
+    return diff(Value::new_value(from), Value::new_value(to), options);
+}
+
+void json::apply_patch(Value &document, const Value &patch) {
+    Patcher patcher(document, false);
+    for (const auto &operation: patch.to_array()) {
+        patcher.apply(*operation);
+    }
+}
+
+void json::apply_patch(Json &document, const Value &patch) {
+    // The members are moved rather than copied, so the document is patched in place and keeps
+    // the operations before a failing one, like the Value overload.
+    Value root = Value::new_value(std::move(document));
+    Patcher patcher(root, true);
+    try {
+        for (const auto &operation: patch.to_array()) {
+            patcher.apply(*operation);
+        }
+    } catch (...) {
+        document = Json(std::move(root.to_object()));
+        throw;
+    }
+    document = Json(std::move(root.to_object()));
+}
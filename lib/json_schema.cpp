@@ -0,0 +1,261 @@
+#include "include/json_schema.h"
+#include "engine.h"
+#include <stdexcept>
+
+using namespace json;
+using namespace json::detail;
+
+namespace {
+    enum TypeBit : std::uint8_t {
+        ObjectBit = 1 << 0,
+        ArrayBit = 1 << 1,
+        StringBit = 1 << 2,
+        IntegerBit = 1 << 3,
+        BooleanBit = 1 << 4,
+        NullBit = 1 << 5
+    };
+
+    std::uint8_t type_bit(const std::string &name) {
+        if (name == "object") {
+            return ObjectBit;
+        }
+        if (name == "array") {
+            return ArrayBit;
+        }
+        if (name == "string") {
+            return StringBit;
+        }
+        if (name == "integer" || name == "number") {
+            return IntegerBit;
+        }
+        if (name == "boolean") {
+            return BooleanBit;
+        }
+        if (name == "null") {
+            return NullBit;
+        }
+        throw std::runtime_error("JSON: Unknown schema type " + name);
+    }
+
+    std::uint8_t token_bit(Token token) {
+        switch (token) {
+            case Token::BeginObject:
+                return ObjectBit;
+            case Token::BeginArray:
+                return ArrayBit;
+            case Token::String:
+                return StringBit;
+            case Token::Uint64:
+                return IntegerBit;
+            case Token::Boolean:
+                return BooleanBit;
+            default:
+                return NullBit;
+        }
+    }
+
+    const char *token_name(Token token) {
+        switch (token) {
+            case Token::BeginObject:
+                return "object";
+            case Token::BeginArray:
+                return "array";
+            case Token::String:
+                return "string";
+            case Token::Uint64:
+                return "integer";
+            case Token::Boolean:
+                return "boolean";
+            default:
+                return "null";
+        }
+    }
+}
+
+Schema Schema::compile(const Value &schema) {
+    Schema ans;
+    ans.compile_node(schema);
+    return ans;
+}
+
+Schema Schema::compile(const Json &schema) {
+    return compile(Value::new_value(schema));
+}
+
+std::size_t Schema::compile_node(const Value &schema) {
+    if (!schema.is_object()) {
+        throw std::runtime_error("JSON: Schema must be an object.");
+    }
+    const std::size_t index = nodes.size();
+    nodes.emplace_back();
+    Node node;
+    for (const auto &[keyword, value]: schema.to_object()) {
+        if (keyword == "type") {
+            node.types = 0;
+            if (value->is_array()) {
+                for (const auto &name: value->to_array()) {
+                    node.types |= type_bit(name->to_string());
+                }
+            } else {
+                node.types = type_bit(value->to_string());
+            }
+        } else if (keyword == "properties") {
+            for (const auto &[name, property]: value->to_object()) {
+                node.properties.push_back({name, compile_node(*property), 0});
+            }
+        } else if (keyword == "items") {
+            node.items = compile_node(*value);
+        } else if (keyword == "enum") {
+            node.has_enum = true;
+            for (const auto &item: value->to_array()) {
+                if (item->is_object() || item->is_array()) {
+                    throw std::runtime_error("JSON: Only scalar enum values are supported.");
+                }
+                node.enum_values.push_back(*item);
+            }
+        } else if (keyword == "minimum") {
+            node.minimum = value->to_uint64();
+        } else if (keyword == "maximum") {
+            node.maximum = value->to_uint64();
+        } else if (keyword == "maxItems") {
+            node.max_items = value->to_uint64();
+        } else if (keyword != "required" && keyword != "$schema" && keyword != "title" && keyword != "description") {
+            throw std::runtime_error("JSON: Unsupported schema keyword " + keyword);
+        }
+    }
+    std::sort(node.properties.begin(), node.properties.end(), [](const Property &lhs, const Property &rhs) {
+        return lhs.name < rhs.name;
+    });
+    if (schema.to_object().count("required")) {
+        const auto &required = schema["required"].to_array();
+        if (required.size() > 64) {
+            throw std::runtime_error("JSON: At most 64 required keys are supported.");
+        }
+        for (std::size_t i = 0; i < required.size(); i++) {
+            const std::string &name = required[i]->to_string();
+            auto it = std::lower_bound(node.properties.begin(), node.properties.end(), name,
+                                       [](const Property &property, const std::string &key) {
+                                           return property.name < key;
+                                       });
+            if (it == node.properties.end() || it->name != name) {
+                it = node.properties.insert(it, {name, npos, 0});
+            }
+            it->required_bit |= std::uint64_t(1) << i;
+            node.required_mask |= std::uint64_t(1) << i;
+        }
+    }
+    nodes[index] = std::move(node);
+    return index;
+}
+
+const Schema::Property *Schema::find_property(const Node &node, std::string_view name) {
+    const auto it = std::lower_bound(node.properties.begin(), node.properties.end(), name,
+                                     [](const Property &property, std::string_view key) {
+                                         return property.name < key;
+                                     });
+    if (it == node.properties.end() || it->name != name) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+void SchemaValidator::reset(const Schema &new_schema) {
+    schema = &new_schema;
+    frames.clear();
+    pending = 0;
+}
+
+void SchemaValidator::accept(Token token, const Tokenizer &tokenizer) {
+    switch (token) {
+        case Token::Key: {
+            Frame &frame = frames.back();
+            pending = Schema::npos;
+            if (frame.node != Schema::npos) {
+                const Schema::Property *property = Schema::find_property(schema->nodes[frame.node], tokenizer.text());
+                if (property != nullptr) {
+                    pending = property->node;
+                    frame.seen |= property->required_bit;
+                }
+            }
+            return;
+        }
+        case Token::EndObject: {
+            const Frame &frame = frames.back();
+            if (frame.node != Schema::npos) {
+                const Schema::Node &node = schema->nodes[frame.node];
+                if ((frame.seen & node.required_mask) != node.required_mask) {
+                    for (const auto &property: node.properties) {
+                        if (property.required_bit != 0 && (frame.seen & property.required_bit) == 0) {
+                            fail("missing required key " + property.name);
+                        }
+                    }
+                }
+            }
+            frames.pop_back();
+            return;
+        }
+        case Token::EndArray:
+            frames.pop_back();
+            return;
+        case Token::End:
+            return;
+        default:
+            break;
+    }
+
+    std::size_t node = 0;
+    if (!frames.empty()) {
+        Frame &parent = frames.back();
+        if (parent.is_object) {
+            node = pending;
+        } else if (parent.node == Schema::npos) {
+            node = Schema::npos;
+        } else {
+            const Schema::Node &parent_node = schema->nodes[parent.node];
+            if (++parent.count > parent_node.max_items) {
+                fail("array has more than " + std::to_string(parent_node.max_items) + " items");
+            }
+            node = parent_node.items;
+        }
+    }
+    if (node != Schema::npos) {
+        check_value(node, token, tokenizer);
+    }
+    if (token == Token::BeginObject || token == Token::BeginArray) {
+        frames.push_back({node, token == Token::BeginObject, 0, 0});
+    }
+}
+
+void SchemaValidator::check_value(std::size_t node, Token token, const Tokenizer &tokenizer) const {
+    const Schema::Node &rule = schema->nodes[node];
+    if ((rule.types & token_bit(token)) == 0) {
+        fail(std::string("unexpected ") + token_name(token));
+    }
+    if (token == Token::Uint64 && (tokenizer.number() < rule.minimum || tokenizer.number() > rule.maximum)) {
+        fail(std::to_string(tokenizer.number()) + " is out of range");
+    }
+    if (!rule.has_enum) {
+        return;
+    }
+    // Enum values are always scalars, so a container can never match one.
+    if (token == Token::BeginObject || token == Token::BeginArray) {
+        fail("value is not one of the enum values");
+    }
+    for (const auto &value: rule.enum_values) {
+        if ((token == Token::String && value.is_string() && value.to_string() == tokenizer.text()) ||
+            (token == Token::Uint64 && value.is_uint64() && value.to_uint64() == tokenizer.number()) ||
+            (token == Token::Boolean && value.is_boolean() && value.to_boolean() == tokenizer.boolean()) ||
+            (token == Token::Null && value.is_null())) {
+            return;
+        }
+    }
+    fail("value is not one of the enum values");
+}
+
+void SchemaValidator::fail(const std::string &what) {
+    throw std::runtime_error("JSON: Schema violation: " + what);
+}
+
+Json json::parse_json(std::istream &s, const Schema &schema, const ParseLimits &limits) {
+    return detail::parse_stream(s, limits, false, &schema);
+}
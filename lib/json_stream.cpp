@@ -0,0 +1,57 @@
+#include "include/json_stream.h"
+#include "engine.h"
+
+using namespace json;
+using namespace json::detail;
+
+Value &ArrayStream::iterator::operator*() const {
+    return *stream->current;
+}
+
+Value *ArrayStream::iterator::operator->() const {
+    return &*stream->current;
+}
+
+ArrayStream::iterator &ArrayStream::iterator::operator++() {
+    stream->advance();
+    return *this;
+}
+
+void ArrayStream::iterator::operator++(int) {
+    stream->advance();
+}
+
+bool ArrayStream::iterator::at_end() const {
+    return stream == nullptr || !stream->current;
+}
+
+ArrayStream::ArrayStream(std::istream &input, const ParseLimits &limits) : state(std::make_unique<ParseState>()) {
+    state->tokenizer.reset(input.rdbuf(), limits, true);
+}
+
+ArrayStream::ArrayStream(std::string_view input, const ParseLimits &limits) : state(std::make_unique<ParseState>()) {
+    state->tokenizer.reset(input, limits, true);
+}
+
+ArrayStream::~ArrayStream() = default;
+
+ArrayStream::iterator ArrayStream::begin() {
+    if (!started) {
+        started = true;
+        state->tokenizer.next();
+        advance();
+    }
+    return iterator(this);
+}
+
+void ArrayStream::advance() {
+    // Free the previous element first so peak memory is one element, not two.
+    current.reset();
+    state->tokenizer.reset_element_count();
+    const Token token = state->tokenizer.next();
+    if (token == Token::EndArray) {
+        state->tokenizer.finish();
+        return;
+    }
+    current = state->builder.build(state->tokenizer, token);
+}
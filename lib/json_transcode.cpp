@@ -0,0 +1,262 @@
+#include "include/json_transcode.h"
+#include "engine.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace json;
+using namespace json::detail;
+
+namespace {
+    constexpr std::size_t flush_threshold = 1 << 16;
+
+    class Writer {
+    public:
+        Writer(std::ostream &out, const Format &format) : out(out), format(format) {}
+
+        void write(Token token, const Tokenizer &tokenizer) {
+            switch (token) {
+                case Token::BeginObject:
+                case Token::BeginArray:
+                    begin_value();
+                    open(token == Token::BeginObject);
+                    break;
+                case Token::EndObject:
+                case Token::EndArray:
+                    close(token == Token::EndObject);
+                    break;
+                case Token::Key:
+                    key(tokenizer.text());
+                    break;
+                case Token::String:
+                    begin_value();
+                    put('\"');
+                    put(tokenizer.text());
+                    put('\"');
+                    break;
+                case Token::Uint64:
+                    begin_value();
+                    put(std::to_string(tokenizer.number()));
+                    break;
+                case Token::Boolean:
+                    begin_value();
+                    put(tokenizer.boolean() ? "true" : "false");
+                    break;
+                case Token::Null:
+                    begin_value();
+                    put("null");
+                    break;
+                case Token::End:
+                    break;
+            }
+            if (buffer.size() >= flush_threshold) {
+                flush();
+            }
+        }
+
+        void finish() {
+            if (format.style == Style::Pretty) {
+                buffer += '\n';
+            }
+            flush();
+        }
+
+    private:
+        struct Frame {
+            std::vector<std::pair<std::string, std::string>> members;
+        };
+
+        // Canonical objects collect their members separately until they are closed and sorted.
+        std::string &target() {
+            return frames.empty() ? buffer : frames.back().members.back().second;
+        }
+
+        void put(char ch) {
+            target() += ch;
+        }
+
+        void put(std::string_view text) {
+            target() += text;
+        }
+
+        void new_line() {
+            put('\n');
+            target().append(depth * format.indent, ' ');
+        }
+
+        // Separator and indentation before an element, or nothing when a key was just written.
+        void begin_value() {
+            if (after_key) {
+                after_key = false;
+            } else {
+                if (need_comma) {
+                    put(',');
+                }
+                if (format.style == Style::Pretty && depth != 0) {
+                    new_line();
+                }
+            }
+            need_comma = true;
+        }
+
+        void open(bool is_object) {
+            if (format.style == Style::Canonical && is_object) {
+                frames.emplace_back();
+                buffered.push_back(true);
+            } else {
+                put(is_object ? '{' : '[');
+                buffered.push_back(false);
+            }
+            depth++;
+            need_comma = false;
+        }
+
+        void close(bool is_object) {
+            depth--;
+            const bool sorted = buffered.back();
+            buffered.pop_back();
+            if (sorted) {
+                Frame frame = std::move(frames.back());
+                frames.pop_back();
+                std::stable_sort(frame.members.begin(), frame.members.end(), [](const auto &lhs, const auto &rhs) {
+                    return lhs.first < rhs.first;
+                });
+                std::string &dest = target();
+                dest += '{';
+                bool first = true;
+                for (std::size_t i = 0; i < frame.members.size(); i++) {
+                    if (i + 1 < frame.members.size() && frame.members[i].first == frame.members[i + 1].first) {
+                        continue;
+                    }
+                    if (!first) {
+                        dest += ',';
+                    }
+                    first = false;
+                    dest += '\"';
+                    dest += frame.members[i].first;
+                    dest += "\":";
+                    dest += frame.members[i].second;
+                }
+                dest += '}';
+            } else {
+                if (format.style == Style::Pretty && need_comma) {
+                    new_line();
+                }
+                put(is_object ? '}' : ']');
+            }
+            need_comma = true;
+        }
+
+        void key(std::string_view name) {
+            if (!buffered.back()) {
+                begin_value();
+                put('\"');
+                put(name);
+                put(format.style == Style::Pretty ? "\": " : "\":");
+            } else {
+                frames.back().members.emplace_back(name, std::string());
+            }
+            after_key = true;
+        }
+
+        void flush() {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+
+        std::ostream &out;
+        const Format &format;
+        std::string buffer;
+        std::vector<Frame> frames;
+        std::vector<bool> buffered;
+        std::size_t depth = 0;
+        bool need_comma = false;
+        bool after_key = false;
+    };
+
+    // Enforces the tree's rule that all elements of an array have the same type, so transcode
+    // accepts exactly the documents parse_json does.
+    class ArrayTypes {
+    public:
+        void accept(Token token) {
+            switch (token) {
+                case Token::EndObject:
+                case Token::EndArray:
+                    containers.pop_back();
+                    return;
+                case Token::Key:
+                case Token::End:
+                    return;
+                default:
+                    break;
+            }
+            if (!containers.empty() && containers.back().is_array) {
+                Container &array = containers.back();
+                const ValueType type = value_type(token);
+                if (!array.has_elements) {
+                    array.has_elements = true;
+                    array.type = type;
+                } else if (array.type != type) {
+                    throw std::runtime_error("JSON: Array can contains only values with similar types.");
+                }
+            }
+            if (token == Token::BeginObject || token == Token::BeginArray) {
+                containers.push_back({token == Token::BeginArray, false, ValueType::Null});
+            }
+        }
+
+    private:
+        struct Container {
+            bool is_array;
+            bool has_elements;
+            ValueType type;
+        };
+
+        static ValueType value_type(Token token) {
+            switch (token) {
+                case Token::BeginObject:
+                    return ValueType::Object;
+                case Token::BeginArray:
+                    return ValueType::Array;
+                case Token::String:
+                    return ValueType::String;
+                case Token::Uint64:
+                    return ValueType::Uint64;
+                case Token::Boolean:
+                    return ValueType::Boolean;
+                default:
+                    return ValueType::Null;
+            }
+        }
+
+        std::vector<Container> containers;
+    };
+
+    // A view ends with the document, so `whole_input` rejects anything but whitespace after it,
+    // as Parser does. Streams keep the rest for the next read.
+    void run(Tokenizer &tokenizer, std::ostream &output, const Format &format, bool whole_input) {
+        Writer writer(output, format);
+        ArrayTypes types;
+        for (Token token = tokenizer.next(); token != Token::End; token = tokenizer.next()) {
+            types.accept(token);
+            writer.write(token, tokenizer);
+        }
+        if (whole_input) {
+            tokenizer.expect_end();
+        }
+        tokenizer.finish();
+        writer.finish();
+    }
+}
+
+void json::transcode(std::istream &input, std::ostream &output, const Format &format, const ParseLimits &limits) {
+    Tokenizer tokenizer;
+    tokenizer.reset(input.rdbuf(), limits);
+    run(tokenizer, output, format, false);
+}
+
+void json::transcode(std::string_view input, std::ostream &output, const Format &format, const ParseLimits &limits) {
+    Tokenizer tokenizer;
+    tokenizer.reset(input, limits);
+    run(tokenizer, output, format, true);
+}
@@ -0,0 +1,246 @@
+#include "kernels.h"
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JSON_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+using namespace json;
+using namespace json::detail;
+
+namespace {
+    bool is_space(char ch) {
+        return ch == ' ' || static_cast<unsigned char>(ch - '\t') <= '\r' - '\t';
+    }
+
+    bool is_digit(char ch) {
+        return static_cast<unsigned char>(ch - '0') <= 9;
+    }
+
+    const char *skip_whitespace_scalar(const char *p, const char *end) {
+        while (p != end && is_space(*p)) {
+            p++;
+        }
+        return p;
+    }
+
+    const char *find_quote_scalar(const char *p, const char *end) {
+        while (p != end && *p != '\"') {
+            p++;
+        }
+        return p;
+    }
+
+    const char *skip_digits_scalar(const char *p, const char *end) {
+        while (p != end && is_digit(*p)) {
+            p++;
+        }
+        return p;
+    }
+
+    constexpr Kernels scalar_kernels{skip_whitespace_scalar, find_quote_scalar, skip_digits_scalar};
+
+#ifdef JSON_X86_DISPATCH
+    // Byte classes are tested with unsigned range checks: ch - low <= high - low.
+
+    __attribute__((target("sse2")))
+    __m128i in_range_sse2(__m128i chunk, char low, char high) {
+        const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(low));
+        return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(high - low))), shifted);
+    }
+
+    __attribute__((target("sse2")))
+    const char *skip_whitespace_sse2(const char *p, const char *end) {
+        if (p == end || !is_space(*p)) {
+            return p;
+        }
+        for (; end - p >= 16; p += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), in_range_sse2(chunk, '\t', '\r'));
+            const auto mask = static_cast<unsigned>(~_mm_movemask_epi8(space)) & 0xffffu;
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return skip_whitespace_scalar(p, end);
+    }
+
+    __attribute__((target("sse2")))
+    const char *find_quote_sse2(const char *p, const char *end) {
+        for (; end - p >= 16; p += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\"'))));
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return find_quote_scalar(p, end);
+    }
+
+    __attribute__((target("sse2")))
+    const char *skip_digits_sse2(const char *p, const char *end) {
+        for (; end - p >= 16; p += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const auto mask = static_cast<unsigned>(~_mm_movemask_epi8(in_range_sse2(chunk, '0', '9'))) & 0xffffu;
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return skip_digits_scalar(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    __m256i in_range_avx2(__m256i chunk, char low, char high) {
+        const __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(low));
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(static_cast<char>(high - low))), shifted);
+    }
+
+    __attribute__((target("avx2")))
+    const char *skip_whitespace_avx2(const char *p, const char *end) {
+        if (p == end || !is_space(*p)) {
+            return p;
+        }
+        for (; end - p >= 32; p += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            const __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                                                  in_range_avx2(chunk, '\t', '\r'));
+            const auto mask = ~static_cast<unsigned>(_mm256_movemask_epi8(space));
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return skip_whitespace_sse2(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char *find_quote_avx2(const char *p, const char *end) {
+        for (; end - p >= 32; p += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\"'))));
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return find_quote_sse2(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char *skip_digits_avx2(const char *p, const char *end) {
+        for (; end - p >= 32; p += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            const auto mask = ~static_cast<unsigned>(_mm256_movemask_epi8(in_range_avx2(chunk, '0', '9')));
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+        return skip_digits_sse2(p, end);
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    __mmask64 in_range_avx512(__m512i chunk, char low, char high) {
+        const __m512i shifted = _mm512_sub_epi8(chunk, _mm512_set1_epi8(low));
+        return _mm512_cmple_epu8_mask(shifted, _mm512_set1_epi8(static_cast<char>(high - low)));
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    const char *skip_whitespace_avx512(const char *p, const char *end) {
+        if (p == end || !is_space(*p)) {
+            return p;
+        }
+        for (; end - p >= 64; p += 64) {
+            const __m512i chunk = _mm512_loadu_si512(p);
+            const __mmask64 space = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(' ')) |
+                                    in_range_avx512(chunk, '\t', '\r');
+            const std::uint64_t mask = ~static_cast<std::uint64_t>(space);
+            if (mask != 0) {
+                return p + __builtin_ctzll(mask);
+            }
+        }
+        return skip_whitespace_avx2(p, end);
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    const char *find_quote_avx512(const char *p, const char *end) {
+        for (; end - p >= 64; p += 64) {
+            const __m512i chunk = _mm512_loadu_si512(p);
+            const auto mask = static_cast<std::uint64_t>(_mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\"')));
+            if (mask != 0) {
+                return p + __builtin_ctzll(mask);
+            }
+        }
+        return find_quote_avx2(p, end);
+    }
+
+    __attribute__((target("avx512f,avx512bw")))
+    const char *skip_digits_avx512(const char *p, const char *end) {
+        for (; end - p >= 64; p += 64) {
+            const __m512i chunk = _mm512_loadu_si512(p);
+            const std::uint64_t mask = ~static_cast<std::uint64_t>(in_range_avx512(chunk, '0', '9'));
+            if (mask != 0) {
+                return p + __builtin_ctzll(mask);
+            }
+        }
+        return skip_digits_avx2(p, end);
+    }
+
+    constexpr Kernels sse2_kernels{skip_whitespace_sse2, find_quote_sse2, skip_digits_sse2};
+    constexpr Kernels avx2_kernels{skip_whitespace_avx2, find_quote_avx2, skip_digits_avx2};
+    constexpr Kernels avx512_kernels{skip_whitespace_avx512, find_quote_avx512, skip_digits_avx512};
+#endif
+
+    Isa detect() {
+#ifdef JSON_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return Isa::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return Isa::Avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return Isa::Sse2;
+        }
+#endif
+        return Isa::Scalar;
+    }
+
+    const Kernels &kernels_for(Isa isa) {
+        switch (isa) {
+#ifdef JSON_X86_DISPATCH
+            case Isa::Avx512:
+                return avx512_kernels;
+            case Isa::Avx2:
+                return avx2_kernels;
+            case Isa::Sse2:
+                return sse2_kernels;
+#endif
+            default:
+                return scalar_kernels;
+        }
+    }
+
+    const Isa detected = detect();
+
+    std::atomic<Isa> active{detected};
+}
+
+const Kernels &json::detail::kernels() {
+    return kernels_for(active.load(std::memory_order_relaxed));
+}
+
+Isa json::detected_isa() {
+    return detected;
+}
+
+Isa json::active_isa() {
+    return active.load(std::memory_order_relaxed);
+}
+
+void json::set_isa(Isa isa) {
+    if (isa > detected) {
+        throw std::runtime_error("JSON: This CPU doesn't support the requested instruction set.");
+    }
+    active.store(isa, std::memory_order_relaxed);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "include/json.h"
+
+namespace json::detail {
+
+    // Hot scanning loops of the tokenizer. Each returns the first position in [begin, end) that
+    // stops the scan, or `end` when there is none.
+    struct Kernels {
+        const char *(*skip_whitespace)(const char *begin, const char *end);
+
+        const char *(*find_quote)(const char *begin, const char *end);
+
+        const char *(*skip_digits)(const char *begin, const char *end);
+    };
+
+    // Kernel set currently selected by set_isa() or, by default, by CPU detection.
+    const Kernels &kernels();
+} // namespace json::detail
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "include/json.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#ifdef JSON_ENABLE_STATS
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+// Statements passed to JSON_STATS only exist in builds with JSON_ENABLE_STATS, so the default
+// build pays nothing for the instrumentation.
+#ifdef JSON_ENABLE_STATS
+#define JSON_STATS(...) __VA_ARGS__
+#else
+#define JSON_STATS(...)
+#endif
+
+namespace json::detail {
+
+#ifdef JSON_ENABLE_STATS
+    inline std::uint64_t cycles() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Adds the cycles spent in its scope to one of the ParseStats phases.
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(std::uint64_t &counter) : counter(counter), start(cycles()) {}
+
+        ~PhaseTimer() {
+            counter += cycles() - start;
+        }
+
+        PhaseTimer(const PhaseTimer &) = delete;
+
+        PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    private:
+        std::uint64_t &counter;
+        std::uint64_t start;
+    };
+
+    // Counts an allocation when `container` grew its buffer within the scope.
+    template<typename Container>
+    class GrowthCounter {
+    public:
+        GrowthCounter(std::uint64_t &counter, const Container &container)
+                : counter(counter), container(container), capacity(container.capacity()) {}
+
+        ~GrowthCounter() {
+            counter += container.capacity() != capacity;
+        }
+
+        GrowthCounter(const GrowthCounter &) = delete;
+
+        GrowthCounter &operator=(const GrowthCounter &) = delete;
+
+    private:
+        std::uint64_t &counter;
+        const Container &container;
+        std::size_t capacity;
+    };
+
+    // Whether copying `text` into a new std::string needs a heap buffer.
+    inline bool allocates(std::string_view text) {
+        return text.size() > std::string().capacity();
+    }
+
+    // Publishes the stats of a finished document to last_parse_stats() and the callback.
+    void report_stats(const ParseStats &stats);
+#endif
+} // namespace json::detail
@@ -0,0 +1,71 @@
+#include <json_stream.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct array_stream_test : ::testing::Test {
+
+    };
+}
+
+TEST_F(array_stream_test, records) {
+    std::string raw_json = "[";
+    for (std::size_t i = 0; i < 1000; i++) {
+        raw_json += (i == 0 ? "" : ",\n") + std::string(R"({"id": )") + std::to_string(i) +
+                    R"(, "tags": ["a", "b"], "name": ")" + std::string(i % 50, 'x') + "\"}";
+    }
+    raw_json += "]";
+    std::stringstream ss(raw_json);
+    std::size_t count = 0;
+    for (const json::Value &record: json::ArrayStream(ss)) {
+        ASSERT_EQ(record["id"].to_uint64(), count);
+        ASSERT_EQ(record["name"].to_string().size(), count % 50);
+        ASSERT_EQ(record["tags"].to_array().size(), 2);
+        count++;
+    }
+    ASSERT_EQ(count, 1000);
+}
+
+TEST_F(array_stream_test, mixed_elements) {
+    json::ArrayStream stream(R"([1, "two", [3], {"four": 4}, null, true])");
+    auto it = stream.begin();
+    ASSERT_EQ(it->to_uint64(), 1);
+    ++it;
+    ASSERT_EQ(it->to_string(), "two");
+    ++it;
+    ASSERT_EQ(it->to_array().front()->to_uint64(), 3);
+    ++it;
+    ASSERT_EQ((*it)["four"].to_uint64(), 4);
+    ++it;
+    ASSERT_TRUE(it->is_null());
+    ++it;
+    ASSERT_TRUE(it->to_boolean());
+    ++it;
+    ASSERT_TRUE(it == stream.end());
+}
+
+TEST_F(array_stream_test, empty_array) {
+    json::ArrayStream stream(" [ ] ");
+    ASSERT_TRUE(stream.begin() == stream.end());
+}
+
+TEST_F(array_stream_test, limits_per_element) {
+    json::ParseLimits limits;
+    limits.max_elements = 3;
+    std::size_t count = 0;
+    for (const auto &record: json::ArrayStream(R"([[1, 2], [3, 4], [5, 6]])", limits)) {
+        ASSERT_EQ(record.to_array().size(), 2);
+        count++;
+    }
+    ASSERT_EQ(count, 3);
+    json::ArrayStream too_big(R"([[1, 2], [3, 4, 5]])", limits);
+    auto it = too_big.begin();
+    ASSERT_THROW(++it, std::runtime_error);
+}
+
+TEST_F(array_stream_test, errors) {
+    ASSERT_THROW(json::ArrayStream(R"({"a": 1})").begin(), std::runtime_error);
+    json::ArrayStream truncated(R"([1, 2)");
+    auto it = truncated.begin();
+    ++it;
+    ASSERT_THROW(++it, std::runtime_error);
+}
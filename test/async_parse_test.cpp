@@ -0,0 +1,157 @@
+#include <json_async.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+namespace {
+    struct async_parse_test : ::testing::Test {
+
+    };
+
+    json::Task<std::uint64_t> read_age(json::AsyncByteSource &source) {
+        json::Json obj = co_await json::async_parse(source);
+        co_return obj["age"].to_uint64();
+    }
+}
+
+TEST_F(async_parse_test, single_chunk) {
+    json::ChunkQueueSource source;
+    source.push(R"({"name": "Jake", "age": 30})");
+    auto task = json::async_parse(source);
+    ASSERT_TRUE(task.done());
+    const json::Json obj = task.get();
+    ASSERT_EQ(obj["name"].to_string(), "Jake");
+    ASSERT_EQ(obj["age"].to_uint64(), 30);
+}
+
+TEST_F(async_parse_test, suspends_between_chunks) {
+    json::ChunkQueueSource source;
+    auto task = json::async_parse(source);
+    ASSERT_FALSE(task.done());
+    source.push(R"({"array": [1,)");
+    ASSERT_FALSE(task.done());
+    source.push(R"( 2], "person": {"na)");
+    ASSERT_FALSE(task.done());
+    source.push(R"(me": "Tom"}})");
+    ASSERT_TRUE(task.done());
+    const json::Json obj = task.get();
+    ASSERT_EQ(obj["array"].to_array().size(), 2);
+    ASSERT_EQ(obj["person"]["name"].to_string(), "Tom");
+}
+
+TEST_F(async_parse_test, braces_inside_strings) {
+    json::ChunkQueueSource source;
+    auto task = json::async_parse(source);
+    source.push(R"({"name": "}")");
+    ASSERT_FALSE(task.done());
+    source.push("}");
+    ASSERT_TRUE(task.done());
+    ASSERT_EQ(task.get()["name"].to_string(), "}");
+}
+
+TEST_F(async_parse_test, awaited_from_coroutine) {
+    json::ChunkQueueSource source;
+    auto task = read_age(source);
+    source.push(R"({"age")");
+    ASSERT_FALSE(task.done());
+    source.push(R"(: 42})");
+    ASSERT_TRUE(task.done());
+    ASSERT_EQ(task.get(), 42);
+}
+
+TEST_F(async_parse_test, dropped_while_suspended) {
+    json::ChunkQueueSource source;
+    {
+        auto task = json::async_parse(source);
+        source.push(R"({"a")");
+        ASSERT_FALSE(task.done());
+    }
+    source.push(R"(: 1})");
+    source.close();
+}
+
+TEST_F(async_parse_test, dropped_while_awaited) {
+    json::ChunkQueueSource source;
+    {
+        auto task = read_age(source);
+        source.push(R"({"age")");
+        ASSERT_FALSE(task.done());
+    }
+    source.push(R"(: 42})");
+    source.close();
+}
+
+TEST_F(async_parse_test, producers_on_other_threads) {
+    constexpr std::size_t count = 256;
+    std::vector<std::unique_ptr<json::ChunkQueueSource>> sources;
+    for (std::size_t i = 0; i < count; i++) {
+        sources.push_back(std::make_unique<json::ChunkQueueSource>());
+    }
+    std::vector<std::thread> producers;
+    for (std::size_t thread = 0; thread < 4; thread++) {
+        producers.emplace_back([&sources, thread] {
+            for (std::size_t i = thread; i < count; i += 4) {
+                sources[i]->push(R"({"ag)");
+                sources[i]->push(R"(e": )" + std::to_string(i));
+                sources[i]->push("}");
+            }
+        });
+    }
+    // Consumers start while the producers are pushing, so both orders of registering and pushing occur.
+    std::vector<json::Task<std::uint64_t>> tasks;
+    for (std::size_t i = 0; i < count; i++) {
+        tasks.push_back(read_age(*sources[i]));
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        ASSERT_TRUE(tasks[i].done());
+        ASSERT_EQ(tasks[i].get(), i);
+    }
+}
+
+TEST_F(async_parse_test, limits) {
+    json::ParseLimits limits;
+    limits.max_document_size = 16;
+    limits.max_depth = 3;
+    json::ChunkQueueSource source;
+    auto task = json::async_parse(source, limits);
+    source.push(R"({"a": "0123)");
+    ASSERT_FALSE(task.done());
+    // Fails as soon as the buffered document passes the limit, without waiting for its end.
+    source.push("456789");
+    ASSERT_TRUE(task.done());
+    ASSERT_THROW(task.get(), std::runtime_error);
+
+    json::ChunkQueueSource nested;
+    auto deep = json::async_parse(nested, limits);
+    nested.push(R"({"a": [[)");
+    ASSERT_FALSE(deep.done());
+    nested.push("[");
+    ASSERT_TRUE(deep.done());
+    ASSERT_THROW(deep.get(), std::runtime_error);
+
+    json::ChunkQueueSource fits;
+    auto small = json::async_parse(fits, limits);
+    fits.push(R"({"a": [[1]]})");
+    ASSERT_TRUE(small.done());
+    ASSERT_EQ(small.get()["a"].to_array().size(), 1);
+}
+
+TEST_F(async_parse_test, truncated_input) {
+    json::ChunkQueueSource source;
+    auto task = json::async_parse(source);
+    source.push(R"({"age": 30)");
+    source.close();
+    ASSERT_TRUE(task.done());
+    ASSERT_THROW(task.get(), std::runtime_error);
+}
+
+TEST_F(async_parse_test, not_an_object) {
+    json::ChunkQueueSource source;
+    auto task = json::async_parse(source);
+    source.push("[1, 2]");
+    ASSERT_TRUE(task.done());
+    ASSERT_THROW(task.get(), std::runtime_error);
+}
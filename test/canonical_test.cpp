@@ -0,0 +1,51 @@
+#include <json_canonical.h>
+#include <json_transcode.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct canonical_test : ::testing::Test {
+        json::Parser parser;
+    };
+}
+
+TEST_F(canonical_test, dump) {
+    std::stringstream ss;
+    json::dump_canonical(ss, parser.parse(R"({"b": [{"y": 1, "x": "z"}], "a": null, "c": {"f": false, "e": 007}})"));
+    ASSERT_EQ(ss.str(), R"({"a":null,"b":[{"x":"z","y":1}],"c":{"e":7,"f":false}})");
+}
+
+TEST_F(canonical_test, matches_transcode) {
+    const std::string raw_json = R"({"name": "Jake Smith", "tags": ["b", "a"], "n": {"z": 18446744073709551615, "a": 0}})";
+    std::stringstream dumped;
+    json::dump_canonical(dumped, parser.parse(raw_json));
+    std::stringstream transcoded;
+    json::transcode(raw_json, transcoded, {json::Style::Canonical});
+    ASSERT_EQ(dumped.str(), transcoded.str());
+}
+
+TEST_F(canonical_test, xxh64_vectors) {
+    ASSERT_EQ(json::fingerprint(std::string_view("")), 0xEF46DB3751D8E999ULL);
+    ASSERT_EQ(json::fingerprint(std::string_view("abc")), 0x44BC2CF5AD770999ULL);
+    ASSERT_EQ(json::fingerprint(std::string_view("Nobody inspects the spammish repetition")), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST_F(canonical_test, fingerprint_is_hash_of_canonical_form) {
+    std::string raw_json = R"({"items": [)";
+    for (std::size_t i = 0; i < 100; i++) {
+        raw_json += (i == 0 ? "" : ", ") + std::string(R"({"id": )") + std::to_string(i) + R"(, "name": "item"})";
+    }
+    raw_json += "]}";
+    const json::Json obj = parser.parse(raw_json);
+    std::stringstream ss;
+    json::dump_canonical(ss, obj);
+    ASSERT_EQ(json::fingerprint(obj), json::fingerprint(ss.str()));
+    ASSERT_EQ(json::fingerprint(obj), json::fingerprint(json::Value::new_value(obj)));
+}
+
+TEST_F(canonical_test, fingerprint_ignores_layout) {
+    const auto lhs = json::fingerprint(parser.parse(R"({"a": 1, "b": [true, false]})"));
+    const auto rhs = json::fingerprint(parser.parse("{\n  \"b\": [true,false],\n  \"a\": 1\n}"));
+    const auto other = json::fingerprint(parser.parse(R"({"a": 2, "b": [true, false]})"));
+    ASSERT_EQ(lhs, rhs);
+    ASSERT_NE(lhs, other);
+}
@@ -0,0 +1,61 @@
+#include <json_frozen.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct frozen_object_test : ::testing::Test {
+
+    };
+}
+
+TEST_F(frozen_object_test, lookups) {
+    std::stringstream ss(R"({"name": "frozen", "count": 3, "tags": ["a", "b"], "nested": {"ok": true}})");
+    const json::Json object = json::parse_json(ss);
+    const json::FrozenObject index(object);
+    ASSERT_EQ(index.size(), 4);
+    ASSERT_EQ(index["name"].to_string(), "frozen");
+    ASSERT_EQ(index["count"].to_uint64(), 3);
+    ASSERT_EQ(index["tags"].to_array().size(), 2);
+    ASSERT_TRUE(index["nested"]["ok"].to_boolean());
+    ASSERT_TRUE(index.contains_key("tags"));
+    ASSERT_FALSE(index.contains_key("tag"));
+    ASSERT_EQ(index.find(""), nullptr);
+    ASSERT_THROW(index["missing"], std::runtime_error);
+}
+
+TEST_F(frozen_object_test, members_are_enumerable) {
+    const json::FrozenObject index(json::Value::new_value(std::unordered_map<std::string, json::value_ptr>{
+            {"a", json::make_value(json::Value::new_value(std::uint64_t(1)))},
+            {"b", json::make_value(json::Value::new_value(std::uint64_t(2)))}}));
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < index.size(); i++) {
+        ASSERT_EQ(index.value(i).to_uint64(), index.key(i) == "a" ? 1 : 2);
+        sum += index.value(i).to_uint64();
+    }
+    ASSERT_EQ(sum, 3);
+}
+
+TEST_F(frozen_object_test, large_object) {
+    std::string raw_json = "{";
+    for (std::size_t i = 0; i < 100000; i++) {
+        raw_json += (i == 0 ? "\"key" : ",\"key") + std::to_string(i) + "\":" + std::to_string(i * 7);
+    }
+    raw_json += "}";
+    json::Parser parser;
+    const json::Json object = parser.parse(raw_json);
+    const json::FrozenObject index(object);
+    ASSERT_EQ(index.size(), 100000);
+    for (std::size_t i = 0; i < 100000; i++) {
+        ASSERT_EQ(index["key" + std::to_string(i)].to_uint64(), i * 7);
+    }
+    ASSERT_FALSE(index.contains_key("key100000"));
+}
+
+TEST_F(frozen_object_test, empty_object) {
+    const json::FrozenObject index{json::Json()};
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_FALSE(index.contains_key("a"));
+}
+
+TEST_F(frozen_object_test, not_an_object) {
+    ASSERT_THROW(json::FrozenObject(json::Value::new_value(std::uint64_t(1))), std::runtime_error);
+}
@@ -0,0 +1,59 @@
+#include <json.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct kernels_test : ::testing::Test {
+        ~kernels_test() override {
+            json::set_isa(json::detected_isa());
+        }
+
+        static std::vector<json::Isa> supported() {
+            std::vector<json::Isa> ans;
+            for (auto isa: {json::Isa::Scalar, json::Isa::Sse2, json::Isa::Avx2, json::Isa::Avx512}) {
+                if (isa <= json::detected_isa()) {
+                    ans.push_back(isa);
+                }
+            }
+            return ans;
+        }
+
+        // Runs of every length around the 16/32/64 byte vector widths.
+        static std::string document() {
+            std::string ans = "{";
+            for (std::size_t i = 0; i < 140; i++) {
+                ans += std::string(i, " \t\r\n"[i % 4]) + "\"k" + std::to_string(i) + "\"" + std::string(i % 7, ' ') + ":";
+                ans += std::string(i, ' ') + "\"" + std::string(i, 'a' + static_cast<char>(i % 26)) + "\",";
+                ans += "\"n" + std::to_string(i) + "\": " + std::string(i % 19, '0') + std::to_string(i * 7919) + ",";
+            }
+            ans += "\"max\": 18446744073709551615}";
+            return ans;
+        }
+    };
+}
+
+TEST_F(kernels_test, detected_is_active_by_default) {
+    ASSERT_EQ(json::active_isa(), json::detected_isa());
+}
+
+TEST_F(kernels_test, unsupported_isa) {
+    if (json::detected_isa() == json::Isa::Avx512) {
+        GTEST_SKIP();
+    }
+    ASSERT_THROW(json::set_isa(json::Isa::Avx512), std::runtime_error);
+}
+
+TEST_F(kernels_test, variants_agree) {
+    const std::string raw_json = document();
+    for (const auto isa: supported()) {
+        json::set_isa(isa);
+        json::Parser parser;
+        const json::Json obj = parser.parse(raw_json);
+        ASSERT_EQ(obj.size(), 281);
+        for (std::size_t i = 0; i < 140; i++) {
+            ASSERT_EQ(obj["k" + std::to_string(i)].to_string(), std::string(i, 'a' + static_cast<char>(i % 26)));
+            ASSERT_EQ(obj["n" + std::to_string(i)].to_uint64(), i * 7919);
+        }
+        ASSERT_EQ(obj["max"].to_uint64(), 18446744073709551615ULL);
+        ASSERT_THROW(parser.parse(R"({"max": 18446744073709551616})"), std::runtime_error);
+    }
+}
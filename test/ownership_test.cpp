@@ -0,0 +1,39 @@
+#include <json.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct ownership_test : ::testing::Test {
+
+    };
+}
+
+TEST_F(ownership_test, local_ptr_counts_copies) {
+    auto first = json::make_local<json::Value>(json::Value::new_value(std::uint64_t(30)));
+    ASSERT_EQ(first.use_count(), 1);
+    {
+        auto second = first;
+        ASSERT_EQ(first.use_count(), 2);
+        ASSERT_EQ(second, first);
+        ASSERT_EQ(second->to_uint64(), 30);
+    }
+    ASSERT_EQ(first.use_count(), 1);
+    auto moved = std::move(first);
+    ASSERT_FALSE(first);
+    ASSERT_EQ(moved.use_count(), 1);
+    ASSERT_EQ(*moved, json::Value::new_value(std::uint64_t(30)));
+}
+
+TEST_F(ownership_test, make_value_moves_payload) {
+    auto value = json::Value::new_value(std::string("a string that does not fit into SSO"));
+    const char *chars = value.to_string().data();
+    const json::value_ptr ptr = json::make_value(std::move(value));
+    ASSERT_EQ(ptr->to_string().data(), chars);
+}
+
+TEST_F(ownership_test, value_copies_share_nodes) {
+    const std::string raw_json = R"({"array": [{"name": "Tom"}]})";
+    std::stringstream ss(raw_json);
+    const json::Json obj = json::parse_json(ss);
+    const json::Value copy = obj["array"];
+    ASSERT_EQ(copy.to_array().front(), obj["array"].to_array().front());
+}
@@ -0,0 +1,80 @@
+#include <json.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct parse_limits_test : ::testing::Test {
+
+    };
+
+    std::string nested_arrays(std::size_t depth) {
+        return "{\"a\": " + std::string(depth, '[') + std::string(depth, ']') + "}";
+    }
+}
+
+TEST_F(parse_limits_test, hostile_nesting) {
+    std::stringstream ss(nested_arrays(1000000));
+    ASSERT_THROW(json::parse_json(ss), std::runtime_error);
+}
+
+TEST_F(parse_limits_test, max_depth) {
+    json::ParseLimits limits;
+    limits.max_depth = 4;
+    std::stringstream ok(nested_arrays(3));
+    const json::Json obj = json::parse_json(ok, limits);
+    ASSERT_EQ(obj["a"].to_array().front()->to_array().front()->to_array().size(), 0);
+    std::stringstream too_deep(nested_arrays(4));
+    ASSERT_THROW(json::parse_json(too_deep, limits), std::runtime_error);
+}
+
+TEST_F(parse_limits_test, max_document_size) {
+    const std::string raw_json = R"({"name": "Jake"})";
+    json::ParseLimits limits;
+    limits.max_document_size = raw_json.size();
+    std::stringstream ok(raw_json + "   ");
+    ASSERT_EQ(json::parse_json(ok, limits)["name"].to_string(), "Jake");
+    limits.max_document_size = raw_json.size() - 1;
+    std::stringstream too_large(raw_json);
+    ASSERT_THROW(json::parse_json(too_large, limits), std::runtime_error);
+    ASSERT_THROW(json::Parser(limits).parse(raw_json), std::runtime_error);
+}
+
+TEST_F(parse_limits_test, max_string_length) {
+    json::ParseLimits limits;
+    limits.max_string_length = 4;
+    json::Parser parser(limits);
+    ASSERT_EQ(parser.parse(R"({"name": "Jake"})")["name"].to_string(), "Jake");
+    ASSERT_THROW(parser.parse(R"({"name": "Jakob"})"), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"names": 1})"), std::runtime_error);
+}
+
+TEST_F(parse_limits_test, max_elements) {
+    json::ParseLimits limits;
+    limits.max_elements = 4;
+    json::Parser parser(limits);
+    ASSERT_EQ(parser.parse(R"({"array": [1, 2]})")["array"].to_array().size(), 2);
+    ASSERT_THROW(parser.parse(R"({"array": [1, 2, 3]})"), std::runtime_error);
+}
+
+TEST_F(parse_limits_test, large_stream) {
+    std::string raw_json = "{\"long\": \"" + std::string(10000, 'x') + "\", \"array\": [";
+    for (std::size_t i = 0; i < 2000; i++) {
+        raw_json += std::to_string(i) + (i + 1 == 2000 ? "" : ", ");
+    }
+    raw_json += "]}";
+    std::stringstream ss(raw_json);
+    const json::Json obj = json::parse_json(ss);
+    ASSERT_EQ(obj["long"].to_string().size(), 10000);
+    ASSERT_EQ(obj["array"].to_array().size(), 2000);
+    ASSERT_EQ(obj["array"].to_array().back()->to_uint64(), 1999);
+}
+
+TEST_F(parse_limits_test, stops_after_document) {
+    std::stringstream ss(R"({"id": 1} {"id": 2})");
+    ASSERT_EQ(json::parse_json(ss)["id"].to_uint64(), 1);
+    ASSERT_EQ(json::parse_json(ss)["id"].to_uint64(), 2);
+}
+
+TEST_F(parse_limits_test, keeps_spaces_in_strings) {
+    std::stringstream ss(R"({"name": "Jake Smith"})");
+    ASSERT_EQ(json::parse_json(ss)["name"].to_string(), "Jake Smith");
+}
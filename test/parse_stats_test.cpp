@@ -0,0 +1,141 @@
+#include <json.h>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+
+// This file is built into a binary of its own, since it replaces the global allocation functions.
+#ifdef JSON_ENABLE_STATS
+namespace {
+    thread_local std::uint64_t allocations = 0;
+}
+
+// Counts real allocations, so ParseStats::estimated_allocations can be checked against them.
+void *operator new(std::size_t size) {
+    allocations++;
+    if (void *ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    allocations++;
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+#endif
+
+namespace {
+    struct parse_stats_test : ::testing::Test {
+        void SetUp() override {
+            if (!json::parse_stats_enabled) {
+                GTEST_SKIP() << "Built without JSON_ENABLE_STATS";
+            }
+        }
+
+        void TearDown() override {
+            json::set_parse_stats_callback({});
+        }
+    };
+}
+
+TEST_F(parse_stats_test, counts_tokens) {
+    const std::string raw_json = R"({"name": "a string that doesn't fit in place", "ids": [1, 2, 3], "ok": true, "none": null, "inner": {}})";
+    json::Parser parser;
+    parser.parse(raw_json);
+    const json::ParseStats &stats = json::last_parse_stats();
+    ASSERT_EQ(stats.objects, 2);
+    ASSERT_EQ(stats.arrays, 1);
+    ASSERT_EQ(stats.keys, 5);
+    ASSERT_EQ(stats.strings, 1);
+    ASSERT_EQ(stats.numbers, 3);
+    ASSERT_EQ(stats.booleans, 1);
+    ASSERT_EQ(stats.nulls, 1);
+    ASSERT_EQ(stats.bytes, raw_json.size());
+}
+
+// The estimate models libstdc++, so it is only exact there.
+#if defined(JSON_ENABLE_STATS) && defined(__GLIBCXX__)
+TEST_F(parse_stats_test, allocations_match_operator_new) {
+    const std::string documents[] = {
+            R"({"a": [1, 2, 3, 4, 5, 6, 7, 8, 9]})",
+            R"({"a key that is too long for the small string buffer": 1})",
+            R"({"name": "a string that doesn't fit in place", "nested": {"deep": [{"x": [[]]}, {}]}, "dup": 1, "dup": 2})",
+            R"({})"};
+    json::Parser parser;
+    // Twice, so both a fresh parser and one reusing its buffers are covered.
+    for (int round = 0; round < 2; round++) {
+        for (const std::string &document: documents) {
+            const std::uint64_t before = allocations;
+            const json::Json obj = parser.parse(document);
+            ASSERT_EQ(json::last_parse_stats().estimated_allocations, allocations - before) << document;
+        }
+    }
+    std::string large = R"({"text": ")" + std::string(10000, 'x') + "\"}";
+    std::stringstream ss(large);
+    const std::uint64_t before = allocations;
+    const json::Json obj = json::parse_json(ss);
+    ASSERT_EQ(json::last_parse_stats().estimated_allocations, allocations - before);
+}
+#endif
+
+TEST_F(parse_stats_test, phases) {
+    std::stringstream ss(R"({"numbers": [12345678901234, 42], "text": "some text"})");
+    json::parse_json(ss);
+    const json::ParseStats &stats = json::last_parse_stats();
+    ASSERT_GT(stats.number_cycles, 0);
+    ASSERT_GT(stats.string_cycles, 0);
+    ASSERT_GT(stats.allocation_cycles, 0);
+    ASSERT_GT(stats.insertion_cycles, 0);
+    ASSERT_GE(stats.total_cycles, stats.number_cycles + stats.string_cycles);
+}
+
+TEST_F(parse_stats_test, stream_bytes_stop_at_document_end) {
+    std::stringstream ss("{\"a\": 1} {\"b\": 2}");
+    json::parse_json(ss);
+    ASSERT_EQ(json::last_parse_stats().bytes, 8);
+    json::parse_json(ss);
+    ASSERT_EQ(json::last_parse_stats().bytes, 9);
+}
+
+TEST_F(parse_stats_test, callback) {
+    std::vector<std::uint64_t> keys;
+    json::set_parse_stats_callback([&keys](const json::ParseStats &stats) {
+        keys.push_back(stats.keys);
+    });
+    json::Parser parser;
+    const std::string_view documents[] = {R"({"a": 1})", R"({"a": 1, "b": 2})", R"({})"};
+    parser.parse_many(documents);
+    ASSERT_EQ(keys, (std::vector<std::uint64_t>{1, 2, 0}));
+}
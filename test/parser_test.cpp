@@ -0,0 +1,50 @@
+#include <json.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct parser_test : ::testing::Test {
+
+    };
+}
+
+TEST_F(parser_test, parse_view) {
+    json::Parser parser;
+    const json::Json obj = parser.parse(R"({"name": "Jake", "age": 30})");
+    ASSERT_EQ(obj["name"].to_string(), "Jake");
+    ASSERT_EQ(obj["age"].to_uint64(), 30);
+}
+
+TEST_F(parser_test, reuse_after_error) {
+    json::Parser parser;
+    ASSERT_THROW(parser.parse(R"({"age": })"), std::runtime_error);
+    ASSERT_THROW(parser.parse(""), std::runtime_error);
+    const json::Json obj = parser.parse(R"({"value": true})");
+    ASSERT_TRUE(obj["value"].to_boolean());
+}
+
+TEST_F(parser_test, trailing_data) {
+    json::Parser parser;
+    ASSERT_THROW(parser.parse(R"({"a": 1} trailing garbage)"), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"a": 1}{"b": 2})"), std::runtime_error);
+    ASSERT_EQ(parser.parse("{\"a\": 1} \n\t")["a"].to_uint64(), 1);
+}
+
+TEST_F(parser_test, trailing_whitespace_past_size_limit) {
+    json::ParseLimits limits;
+    limits.max_document_size = 8;
+    json::Parser parser(limits);
+    ASSERT_EQ(parser.parse("{\"a\": 1}\n")["a"].to_uint64(), 1);
+    ASSERT_THROW(parser.parse("{\"a\": 1} x"), std::runtime_error);
+    ASSERT_THROW(parser.parse("{\"a\": 12}"), std::runtime_error);
+}
+
+TEST_F(parser_test, parse_many) {
+    json::Parser parser;
+    const std::vector<std::string_view> inputs = {R"({"id": 1})", R"({"id": 2, "tags": ["a"]})", R"({"id": 3})"};
+    const std::vector<json::Json> docs = parser.parse_many(inputs);
+    ASSERT_EQ(docs.size(), inputs.size());
+    for (std::size_t i = 0; i < docs.size(); i++) {
+        ASSERT_EQ(docs[i]["id"].to_uint64(), i + 1);
+    }
+    ASSERT_EQ(docs[1]["tags"].to_array().size(), 1);
+}
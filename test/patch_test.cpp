@@ -0,0 +1,178 @@
+#include <json_patch.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace {
+    struct patch_test : ::testing::Test {
+        json::Value parse(std::string_view raw_json) {
+            return json::Value::new_value(parser.parse(raw_json));
+        }
+
+        void expect_round_trip(std::string_view from, std::string_view to) {
+            json::Value document = parse(from);
+            const json::Value target = parse(to);
+            json::apply_patch(document, json::diff(document, target));
+            ASSERT_EQ(document, target);
+        }
+
+        json::Parser parser;
+    };
+}
+
+TEST_F(patch_test, identical_documents) {
+    const json::Value document = parse(R"({"name": "Tom", "tags": ["a", "b"], "person": {"age": 30}})");
+    ASSERT_TRUE(json::diff(document, parse(R"({"person": {"age": 30}, "tags": ["a", "b"], "name": "Tom"})"))
+                        .to_array().empty());
+}
+
+TEST_F(patch_test, object_members) {
+    const json::Value patch = json::diff(parse(R"({"name": "Tom", "age": 30, "person": {"city": "Oslo"}})"),
+                                         parse(R"({"name": "Tom", "active": true, "person": {"city": "Rome"}})"));
+    ASSERT_EQ(patch.to_array().size(), 3);
+    for (const auto &operation: patch.to_array()) {
+        const std::string &path = (*operation)["path"].to_string();
+        const std::string &op = (*operation)["op"].to_string();
+        if (path == "/age") {
+            ASSERT_EQ(op, "remove");
+        } else if (path == "/active") {
+            ASSERT_EQ(op, "add");
+            ASSERT_TRUE((*operation)["value"].to_boolean());
+        } else {
+            ASSERT_EQ(path, "/person/city");
+            ASSERT_EQ(op, "replace");
+            ASSERT_EQ((*operation)["value"].to_string(), "Rome");
+        }
+    }
+}
+
+TEST_F(patch_test, array_insertion) {
+    const json::Value patch = json::diff(parse(R"({"array": [1, 2, 3, 4]})"), parse(R"({"array": [1, 2, 9, 3, 4]})"));
+    ASSERT_EQ(patch.to_array().size(), 1);
+    ASSERT_EQ((*patch.to_array()[0])["op"].to_string(), "add");
+    ASSERT_EQ((*patch.to_array()[0])["path"].to_string(), "/array/2");
+    ASSERT_EQ((*patch.to_array()[0])["value"].to_uint64(), 9);
+}
+
+TEST_F(patch_test, keyed_array) {
+    const json::Value patch = json::diff(
+            parse(R"({"users": [{"id": 1, "name": "Tom"}, {"id": 2, "name": "Jake"}, {"id": 3, "name": "Dan"}]})"),
+            parse(R"({"users": [{"id": 1, "name": "Tom"}, {"id": 3, "name": "Daniel"}]})"));
+    ASSERT_EQ(patch.to_array().size(), 2);
+    ASSERT_EQ((*patch.to_array()[0])["op"].to_string(), "remove");
+    ASSERT_EQ((*patch.to_array()[0])["path"].to_string(), "/users/1");
+    ASSERT_EQ((*patch.to_array()[1])["op"].to_string(), "replace");
+    ASSERT_EQ((*patch.to_array()[1])["path"].to_string(), "/users/1/name");
+}
+
+TEST_F(patch_test, keyed_reorder) {
+    const json::Value patch = json::diff(
+            parse(R"({"users": [{"id": 1, "name": "Tom"}, {"id": 2, "name": "Jake"}, {"id": 3, "name": "Dan"}]})"),
+            parse(R"({"users": [{"id": 3, "name": "Dan"}, {"id": 1, "name": "Tom"}, {"id": 2, "name": "Jacob"}]})"));
+    ASSERT_EQ(patch.to_array().size(), 2);
+    ASSERT_EQ((*patch.to_array()[0])["op"].to_string(), "move");
+    ASSERT_EQ((*patch.to_array()[0])["from"].to_string(), "/users/2");
+    ASSERT_EQ((*patch.to_array()[0])["path"].to_string(), "/users/0");
+    ASSERT_EQ((*patch.to_array()[1])["op"].to_string(), "replace");
+    ASSERT_EQ((*patch.to_array()[1])["path"].to_string(), "/users/2/name");
+
+    const json::Value backward = json::diff(
+            parse(R"({"users": [{"id": 1}, {"id": 2}, {"id": 3}, {"id": 4}]})"),
+            parse(R"({"users": [{"id": 2}, {"id": 3}, {"id": 4}, {"id": 1}]})"));
+    ASSERT_EQ(backward.to_array().size(), 1);
+    ASSERT_EQ((*backward.to_array()[0])["op"].to_string(), "move");
+}
+
+TEST_F(patch_test, keyed_round_trips) {
+    std::mt19937 random(7);
+    for (int round = 0; round < 200; round++) {
+        std::vector<int> ids(random() % 12);
+        std::iota(ids.begin(), ids.end(), 0);
+        const auto records = [&](const std::vector<int> &keys) {
+            std::string ans = R"({"a": [)";
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                ans += (i == 0 ? "" : ", ") + std::string(R"({"id": )") + std::to_string(keys[i]) +
+                       R"(, "v": )" + std::to_string(keys[i] % 3 == 0 ? round : 0) + "}";
+            }
+            return ans + "]}";
+        };
+        std::vector<int> target = ids;
+        std::shuffle(target.begin(), target.end(), random);
+        target.resize(target.size() - (target.empty() ? 0 : random() % (target.size() / 2 + 1)));
+        for (int extra = static_cast<int>(random() % 3); extra > 0; extra--) {
+            target.insert(target.begin() + static_cast<std::ptrdiff_t>(random() % (target.size() + 1)), 100 + extra);
+        }
+        expect_round_trip(records(ids), records(target));
+    }
+}
+
+TEST_F(patch_test, element_type_change) {
+    expect_round_trip(R"({"a": [1, 2]})", R"({"a": ["x", "y"]})");
+    expect_round_trip(R"({"a": [[1], [2]]})", R"({"a": [{"b": 1}]})");
+}
+
+TEST_F(patch_test, round_trips) {
+    expect_round_trip(R"({"a": [1, 2, 3], "b": {"c": "d"}})", R"({"a": [3, 2, 1, 0], "b": {"e": "d"}})");
+    expect_round_trip(R"({"a": [[1], [2, 3]], "b": "x"})", R"({"a": [[2, 3], [1], []], "b": ["x"]})");
+    expect_round_trip(R"({"a": [{"id": 1}, {"id": 2}, {"id": 3}]})", R"({"a": [{"id": 3}, {"id": 1, "x": true}]})");
+    expect_round_trip(R"({"a/b": {"c~d": 1}})", R"({"a/b": {"c~d": 2}})");
+}
+
+TEST_F(patch_test, apply_operations) {
+    json::Json document = parser.parse(R"({"a": {"b": [1, 2]}, "c": "x"})");
+    const json::Value patch = parse(R"({"ops": [
+        {"op": "test", "path": "/c", "value": "x"},
+        {"op": "add", "path": "/a/b/-", "value": 3},
+        {"op": "add", "path": "/a/b/0", "value": 0},
+        {"op": "replace", "path": "/c", "value": "y"},
+        {"op": "copy", "from": "/a/b", "path": "/d"},
+        {"op": "move", "from": "/c", "path": "/a/e"},
+        {"op": "remove", "path": "/a/b/1"}
+    ]})")["ops"];
+    json::apply_patch(document, patch);
+    ASSERT_EQ(json::Value::new_value(document), parse(R"({"a": {"b": [0, 2, 3], "e": "y"}, "d": [0, 1, 2, 3]})"));
+}
+
+TEST_F(patch_test, failed_operations) {
+    json::Value document = parse(R"({"a": [1], "c": "x"})");
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "test", "path": "/c", "value": "y"}]})")["p"]),
+                 std::runtime_error);
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "remove", "path": "/missing"}]})")["p"]),
+                 std::runtime_error);
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "add", "path": "/a/5", "value": 1}]})")["p"]),
+                 std::runtime_error);
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "move", "from": "/a", "path": "/a/0"}]})")["p"]),
+                 std::runtime_error);
+}
+
+TEST_F(patch_test, failed_patch_on_json) {
+    json::Json document = parser.parse(R"({"a": {"x": 1}, "b": 1})");
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [
+        {"op": "remove", "path": "/b"},
+        {"op": "replace", "path": "/a/x", "value": 2},
+        {"op": "remove", "path": "/zzz"}
+    ]})")["p"]), std::runtime_error);
+    ASSERT_EQ(json::Value::new_value(document), parse(R"({"a": {"x": 2}})"));
+
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [
+        {"op": "add", "path": "/c", "value": 3},
+        {"op": "replace", "path": "", "value": [1]}
+    ]})")["p"]), std::runtime_error);
+    ASSERT_EQ(json::Value::new_value(document), parse(R"({"a": {"x": 2}, "c": 3})"));
+}
+
+TEST_F(patch_test, keeps_arrays_homogeneous) {
+    json::Value document = parse(R"({"a": [1, 2], "b": [3], "c": "x"})");
+    // Parsed separately: a copy of a Value shares its subtrees and would change along with it.
+    const json::Value original = parse(R"({"a": [1, 2], "b": [3], "c": "x"})");
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "add", "path": "/a/-", "value": "x"}]})")["p"]),
+                 std::runtime_error);
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "replace", "path": "/a/0", "value": "x"}]})")["p"]),
+                 std::runtime_error);
+    ASSERT_THROW(json::apply_patch(document, parse(R"({"p": [{"op": "move", "from": "/c", "path": "/a/0"}]})")["p"]),
+                 std::runtime_error);
+    ASSERT_EQ(document, original);
+    json::apply_patch(document, parse(R"({"p": [{"op": "replace", "path": "/b/0", "value": "y"}]})")["p"]);
+    ASSERT_EQ(document["b"].to_array()[0]->to_string(), "y");
+}
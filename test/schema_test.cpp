@@ -0,0 +1,69 @@
+#include <json_schema.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct schema_test : ::testing::Test {
+        schema_test() : schema(json::Schema::compile(json::Parser().parse(R"({
+            "type": "object",
+            "required": ["id", "name"],
+            "properties": {
+                "id": {"type": "integer", "minimum": 1, "maximum": 1000},
+                "name": {"type": "string"},
+                "role": {"enum": ["admin", "user"]},
+                "tags": {"type": "array", "maxItems": 2, "items": {"type": "string"}},
+                "owner": {"type": ["object", "null"], "required": ["id"]}
+            }
+        })"))) {}
+
+        json::Parser parser;
+        json::Schema schema;
+    };
+}
+
+TEST_F(schema_test, valid_document) {
+    const json::Json obj = parser.parse(
+            R"({"id": 7, "name": "Tom", "role": "admin", "tags": ["a", "b"], "owner": {"id": 1}, "extra": [1]})", schema);
+    ASSERT_EQ(obj["id"].to_uint64(), 7);
+    ASSERT_EQ(obj["tags"].to_array().size(), 2);
+}
+
+TEST_F(schema_test, stream_overload) {
+    std::stringstream ss(R"({"id": 7, "name": "Tom", "owner": null})");
+    ASSERT_TRUE(json::parse_json(ss, schema)["owner"].is_null());
+}
+
+TEST_F(schema_test, violations) {
+    ASSERT_THROW(parser.parse(R"({"id": 7})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": "7", "name": "Tom"})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 0, "name": "Tom"})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 1001, "name": "Tom"})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 7, "name": "Tom", "role": "root"})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 7, "name": "Tom", "role": {}})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 7, "name": "Tom", "role": [1]})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 7, "name": "Tom", "tags": ["a", "b", "c"]})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 7, "name": "Tom", "tags": [1]})", schema), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"id": 7, "name": "Tom", "owner": {}})", schema), std::runtime_error);
+}
+
+TEST_F(schema_test, rejects_before_reading_the_rest) {
+    // The violation comes before the syntax error, so the schema error is the one reported.
+    try {
+        parser.parse(R"({"id": "bad", "name": )", schema);
+        FAIL();
+    } catch (const std::runtime_error &e) {
+        ASSERT_NE(std::string(e.what()).find("Schema violation"), std::string::npos);
+    }
+}
+
+TEST_F(schema_test, empty_enum) {
+    const json::Schema nothing = json::Schema::compile(parser.parse(R"({"properties": {"a": {"enum": []}}})"));
+    ASSERT_THROW(parser.parse(R"({"a": 1})", nothing), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"a": null})", nothing), std::runtime_error);
+    ASSERT_THROW(parser.parse(R"({"a": {}})", nothing), std::runtime_error);
+    ASSERT_EQ(parser.parse(R"({"b": 1})", nothing)["b"].to_uint64(), 1);
+}
+
+TEST_F(schema_test, unsupported_keyword) {
+    ASSERT_THROW(json::Schema::compile(parser.parse(R"({"pattern": "a*"})")), std::runtime_error);
+    ASSERT_THROW(json::Schema::compile(parser.parse(R"({"enum": [[1]]})")), std::runtime_error);
+}
@@ -44,9 +44,9 @@ TEST_F(simple_parse_test, null_test) {
 }
 
 TEST_F(simple_parse_test, array_test_string) {
-    const std::vector<std::shared_ptr<json::Value>> array = {
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Jake"))),
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Tom")))};
+    const std::vector<json::value_ptr> array = {
+            json::make_value(json::Value::new_value(std::string("Jake"))),
+            json::make_value(json::Value::new_value(std::string("Tom")))};
     const std::string raw_json = R"({"array": ["Jake", "Tom"]})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
@@ -60,9 +60,9 @@ TEST_F(simple_parse_test, array_test_string) {
 
 
 TEST_F(simple_parse_test, array_test_number) {
-    const std::vector<std::shared_ptr<json::Value>> array = {
-            std::make_shared<json::Value>(json::Value::new_value(std::uint64_t(1))),
-            std::make_shared<json::Value>(json::Value::new_value(std::uint64_t(2)))};
+    const std::vector<json::value_ptr> array = {
+            json::make_value(json::Value::new_value(std::uint64_t(1))),
+            json::make_value(json::Value::new_value(std::uint64_t(2)))};
     const std::string raw_json = R"({"array": [1, 2]})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
@@ -75,9 +75,9 @@ TEST_F(simple_parse_test, array_test_number) {
 }
 
 TEST_F(simple_parse_test, array_test_boolean) {
-    const std::vector<std::shared_ptr<json::Value>> array = {
-            std::make_shared<json::Value>(json::Value::new_value(true)),
-            std::make_shared<json::Value>(json::Value::new_value(false))};
+    const std::vector<json::value_ptr> array = {
+            json::make_value(json::Value::new_value(true)),
+            json::make_value(json::Value::new_value(false))};
     const std::string raw_json = R"({"array": [true, false]})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
@@ -90,9 +90,9 @@ TEST_F(simple_parse_test, array_test_boolean) {
 }
 
 TEST_F(simple_parse_test, array_test_null) {
-    const std::vector<std::shared_ptr<json::Value>> array = {
-            std::make_shared<json::Value>(json::Value::new_value(nullptr)),
-            std::make_shared<json::Value>(json::Value::new_value(nullptr))};
+    const std::vector<json::value_ptr> array = {
+            json::make_value(json::Value::new_value(nullptr)),
+            json::make_value(json::Value::new_value(nullptr))};
     const std::string raw_json = R"({"array": [null, null]})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
@@ -105,12 +105,12 @@ TEST_F(simple_parse_test, array_test_null) {
 }
 
 TEST_F(simple_parse_test, array_test_array) {
-    const std::vector<std::shared_ptr<json::Value>> inner = {
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Jake"))),
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Tom")))};
-    const std::vector<std::shared_ptr<json::Value>> array = {
-            std::make_shared<json::Value>(json::Value::new_value(inner)),
-            std::make_shared<json::Value>(json::Value::new_value(inner))};
+    const std::vector<json::value_ptr> inner = {
+            json::make_value(json::Value::new_value(std::string("Jake"))),
+            json::make_value(json::Value::new_value(std::string("Tom")))};
+    const std::vector<json::value_ptr> array = {
+            json::make_value(json::Value::new_value(inner)),
+            json::make_value(json::Value::new_value(inner))};
     const std::string raw_json = R"({"array": [["Jake", "Tom"], ["Jake", "Tom"]]})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
@@ -127,12 +127,12 @@ TEST_F(simple_parse_test, array_test_array) {
 }
 
 TEST_F(simple_parse_test, array_test_object) {
-    std::unordered_map<std::string, std::shared_ptr<json::Value>> object;
-    object["name"] = std::make_shared<json::Value>(json::Value::new_value(std::string("Tom")));
-    object["age"] = std::make_shared<json::Value>(json::Value::new_value(std::uint64_t(30)));
-    const std::vector<std::shared_ptr<json::Value>> array = {
-            std::make_shared<json::Value>(json::Value::new_value(object)),
-            std::make_shared<json::Value>(json::Value::new_value(object))};
+    std::unordered_map<std::string, json::value_ptr> object;
+    object["name"] = json::make_value(json::Value::new_value(std::string("Tom")));
+    object["age"] = json::make_value(json::Value::new_value(std::uint64_t(30)));
+    const std::vector<json::value_ptr> array = {
+            json::make_value(json::Value::new_value(object)),
+            json::make_value(json::Value::new_value(object))};
     const std::string raw_json = R"({"array": [{"name": "Tom", "age": 30}, {"name": "Tom", "age": 30}]})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
@@ -150,15 +150,15 @@ TEST_F(simple_parse_test, array_test_object) {
 }
 
 TEST_F(simple_parse_test, object_test) {
-    std::map<std::string, std::shared_ptr<json::Value>> object;
-    object["name"] = std::make_shared<json::Value>(json::Value::new_value(std::string("Tom")));
-    object["age"] = std::make_shared<json::Value>(json::Value::new_value(std::uint64_t(30)));
+    std::map<std::string, json::value_ptr> object;
+    object["name"] = json::make_value(json::Value::new_value(std::string("Tom")));
+    object["age"] = json::make_value(json::Value::new_value(std::uint64_t(30)));
     const std::string raw_json = R"({ "person": {"name": "Tom", "age": 30}})";
     std::stringstream ss(raw_json);
     const json::Json obj = json::parse_json(ss);
     ASSERT_TRUE(obj.contains_key("person"));
     ASSERT_TRUE(obj["person"].is_object());
-    const std::map<std::string, std::shared_ptr<json::Value>> sorted_data(obj["person"].to_object().begin(),
+    const std::map<std::string, json::value_ptr> sorted_data(obj["person"].to_object().begin(),
                                                                           obj["person"].to_object().end());
     ASSERT_EQ(object.size(), sorted_data.size());
     for (const auto &item: object) {
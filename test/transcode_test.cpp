@@ -0,0 +1,74 @@
+#include <json_transcode.h>
+#include <gtest/gtest.h>
+
+namespace {
+    struct transcode_test : ::testing::Test {
+        static std::string transcode(std::string_view input, const json::Format &format) {
+            std::stringstream out;
+            json::transcode(input, out, format);
+            return out.str();
+        }
+
+        const std::string raw_json = R"({ "name" : "Jake Smith",
+            "tags": [ "a", "b" ], "empty": {}, "none": [],
+            "person": {"age": 30, "active": true, "car": null} })";
+    };
+}
+
+TEST_F(transcode_test, compact) {
+    ASSERT_EQ(transcode(raw_json, {json::Style::Compact}),
+              R"({"name":"Jake Smith","tags":["a","b"],"empty":{},"none":[],"person":{"age":30,"active":true,"car":null}})");
+}
+
+TEST_F(transcode_test, pretty) {
+    ASSERT_EQ(transcode(R"({"tags": ["a", "b"], "empty": {}, "person": {"age": 30}})", {json::Style::Pretty, 2}),
+              "{\n"
+              "  \"tags\": [\n"
+              "    \"a\",\n"
+              "    \"b\"\n"
+              "  ],\n"
+              "  \"empty\": {},\n"
+              "  \"person\": {\n"
+              "    \"age\": 30\n"
+              "  }\n"
+              "}\n");
+}
+
+TEST_F(transcode_test, canonical) {
+    ASSERT_EQ(transcode(raw_json, {json::Style::Canonical}),
+              R"({"empty":{},"name":"Jake Smith","none":[],"person":{"active":true,"age":30,"car":null},"tags":["a","b"]})");
+    ASSERT_EQ(transcode(R"({"b": [{"y": 1, "x": 2}, {"b": 1, "a": 2}], "a": 1, "b": 3})", {json::Style::Canonical}),
+              R"({"a":1,"b":3})");
+    ASSERT_EQ(transcode(R"({"b": [{"y": 1, "x": 2}, {"b": 1, "a": 2}], "a": 1})", {json::Style::Canonical}),
+              R"({"a":1,"b":[{"x":2,"y":1},{"a":2,"b":1}]})");
+}
+
+TEST_F(transcode_test, stream_input) {
+    std::string big = "{\"array\": [";
+    for (std::size_t i = 0; i < 20000; i++) {
+        big += (i == 0 ? "" : ", ") + std::to_string(i);
+    }
+    big += "]}";
+    std::stringstream in(big + " trailing");
+    std::stringstream out;
+    json::transcode(in, out);
+    std::string expected = big;
+    expected.erase(std::remove(expected.begin(), expected.end(), ' '), expected.end());
+    ASSERT_EQ(out.str(), expected);
+    std::string rest;
+    in >> rest;
+    ASSERT_EQ(rest, "trailing");
+}
+
+TEST_F(transcode_test, validates) {
+    ASSERT_THROW(transcode(R"({"a": [1, 2})", {}), std::runtime_error);
+    ASSERT_THROW(transcode(R"({"a" 1})", {}), std::runtime_error);
+    ASSERT_THROW(transcode(R"({"a": 1,})", {}), std::runtime_error);
+    ASSERT_THROW(transcode(R"({"a": [1, "x"]})", {}), std::runtime_error);
+    ASSERT_THROW(transcode(R"({"a": [[1], {}]})", {}), std::runtime_error);
+    ASSERT_THROW(transcode(R"({"a": [null, true]})", {}), std::runtime_error);
+    ASSERT_THROW(transcode(R"({"a": 1} garbage)", {}), std::runtime_error);
+    ASSERT_EQ(transcode("{\"a\": 1}\n", {}), R"({"a":1})");
+    ASSERT_EQ(transcode(R"({"a": [[1], ["x"], []], "b": [{"c": 1}, {"d": "x"}]})", {}),
+              R"({"a":[[1],["x"],[]],"b":[{"c":1},{"d":"x"}]})");
+}
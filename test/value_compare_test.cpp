@@ -38,25 +38,33 @@ TEST_F(value_compare_test, null_test) {
 }
 
 TEST_F(value_compare_test, array_test) {
-    std::vector<std::shared_ptr<json::Value>> arr = {
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Tom"))),
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Jake")))};
+    std::vector<json::value_ptr> arr = {
+            json::make_value(json::Value::new_value(std::string("Tom"))),
+            json::make_value(json::Value::new_value(std::string("Jake")))};
     auto v1 = json::Value::new_value(arr);
     auto v2 = json::Value::new_value(arr);
-    auto v3 = json::Value::new_value(std::vector<std::shared_ptr<json::Value>>{
-            std::make_shared<json::Value>(json::Value::new_value(std::string("Tom")))});
+    auto v3 = json::Value::new_value(std::vector<json::value_ptr>{
+            json::make_value(json::Value::new_value(std::string("Tom")))});
     ASSERT_EQ(v1, v2);
     ASSERT_NE(v1, v3);
 }
 
 TEST_F(value_compare_test, object_test) {
-    std::unordered_map<std::string, std::shared_ptr<json::Value>> object;
-    object["name"] = std::make_shared<json::Value>(json::Value::new_value(std::string("Tom")));
-    object["age"] = std::make_shared<json::Value>(json::Value::new_value(std::uint64_t(30)));
+    std::unordered_map<std::string, json::value_ptr> object;
+    object["name"] = json::make_value(json::Value::new_value(std::string("Tom")));
+    object["age"] = json::make_value(json::Value::new_value(std::uint64_t(30)));
     auto v1 = json::Value::new_value(object);
     auto v2 = json::Value::new_value(object);
-    object["test"] = std::make_shared<json::Value>(json::Value::new_value(true));
+    object["test"] = json::make_value(json::Value::new_value(true));
     auto v3 = json::Value::new_value(object);
     ASSERT_EQ(v1, v2);
     ASSERT_NE(v1, v3);
-}
\ No newline at end of file
+}
+
+TEST_F(value_compare_test, array_compares_elements_by_value) {
+    auto v1 = json::Value::new_value(std::vector<json::value_ptr>{
+            json::make_value(json::Value::new_value(std::string("Tom")))});
+    auto v2 = json::Value::new_value(std::vector<json::value_ptr>{
+            json::make_value(json::Value::new_value(std::string("Tom")))});
+    ASSERT_EQ(v1, v2);
+}